@@ -0,0 +1,553 @@
+//----------------------------------------------------------------------
+//   Copyright 2007-2011 Mentor Graphics Corporation
+//   Copyright 2007-2011 Cadence Design Systems, Inc.
+//   Copyright 2010-2011 Synopsys, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+//
+// uvm_report_index
+//
+// Builds a time/id/severity index over a binary report stream written
+// by uvm_report_server (see +UVM_REPORT_STREAM and
+// src/dpi/uvm_report_stream.c) and answers queries against it.
+//
+// The index is stored next to the stream as <stream>.idx and is rebuilt
+// automatically whenever the stream is newer or has a different size.
+// Queries only touch the index and the matching records, so triaging a
+// multi-GB regression log does not require a full scan.
+//
+// Build:
+//
+//   g++ -O2 -o uvm_report_index uvm_report_index.cc
+//
+// Usage:
+//
+//   uvm_report_index index   <stream>
+//   uvm_report_index summary <stream>
+//   uvm_report_index query   <stream> [-from <t>] [-to <t>] [-id <id>]
+//                            [-severity <sev>] [-first] [-count]
+//                            [-limit <n>]
+//
+// <sev> is one of INFO, WARNING, ERROR, FATAL (with or without the
+// UVM_ prefix, in any case). -severity selects that severity and above.
+//
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef unsigned long long u64;
+typedef unsigned int       u32;
+typedef unsigned char      u8;
+
+static const char    stream_magic[8] = { 'U','V','M','R','P','T','S','\0' };
+static const char    index_magic[8]  = { 'U','V','M','R','P','T','I','\0' };
+static const u32     stream_version  = 1;
+static const u32     index_version   = 1;
+static const u32     msg_fixed       = 33;
+static const char   *sev_names[]     = { "UVM_INFO", "UVM_WARNING",
+                                         "UVM_ERROR", "UVM_FATAL" };
+
+static u32 get_u32(const u8 *p)
+{
+  return (u32) p[0] | ((u32) p[1] << 8) | ((u32) p[2] << 16) | ((u32) p[3] << 24);
+}
+
+static u64 get_u64(const u8 *p)
+{
+  return (u64) get_u32(p) | ((u64) get_u32(p + 4) << 32);
+}
+
+
+//------------------------------------------------------------------------------
+// mapped_file
+//
+// Read-only memory mapping of a whole file.
+//------------------------------------------------------------------------------
+
+class mapped_file {
+public:
+  const u8 *data;
+  size_t    size;
+  time_t    mtime;
+
+  mapped_file() : data(0), size(0), mtime(0) {}
+  ~mapped_file() { close(); }
+
+  bool open(const std::string &path) {
+    struct stat st;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    if (fstat(fd, &st) != 0) {
+      ::close(fd);
+      return false;
+    }
+    size  = st.st_size;
+    mtime = st.st_mtime;
+    if (size > 0) {
+      void *p = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+        ::close(fd);
+        return false;
+      }
+      data = (const u8*) p;
+    }
+    ::close(fd);
+    return true;
+  }
+
+  void close() {
+    if (data)
+      munmap((void*) data, size);
+    data = 0;
+    size = 0;
+  }
+};
+
+
+//------------------------------------------------------------------------------
+// report_index
+//
+// Columnar index over the MSG records of a stream. Records are kept in
+// time order; ~by_id~ holds record numbers sorted by (id, time) with
+// ~id_start~ delimiting the slice of each id.
+//------------------------------------------------------------------------------
+
+struct report_index {
+  u64                      stream_size;
+  std::vector<u64>         times;
+  std::vector<u64>         offsets;   // offset of the MSG payload in the stream
+  std::vector<u32>         ids;
+  std::vector<u8>          sevs;
+  std::vector<u32>         by_id;
+  std::vector<u32>         id_start;
+  std::vector<std::string> strs;
+
+  u32 num_records() const { return (u32) times.size(); }
+
+  bool build(const mapped_file &f);
+  bool save(const std::string &path) const;
+  bool load(const mapped_file &f, u64 expected_stream_size);
+  int  find_str(const std::string &s) const;
+};
+
+
+bool report_index::build(const mapped_file &f)
+{
+  struct rec { u64 time; u64 off; u32 id; u8 sev; };
+  std::vector<rec> recs;
+  size_t pos = 16;
+  bool sorted = true;
+
+  if (f.size < 16 || memcmp(f.data, stream_magic, 8) != 0) {
+    fprintf(stderr, "uvm_report_index: not a UVM report stream\n");
+    return false;
+  }
+  if (get_u32(f.data + 8) != stream_version) {
+    fprintf(stderr, "uvm_report_index: unsupported stream version %u\n",
+            get_u32(f.data + 8));
+    return false;
+  }
+
+  stream_size = f.size;
+  strs.clear();
+
+  // A truncated trailing record (simulation killed mid-write) is ignored
+  while (pos + 5 <= f.size) {
+    u8  kind = f.data[pos];
+    u32 len  = get_u32(f.data + pos + 1);
+    const u8 *p = f.data + pos + 5;
+    if (pos + 5 + len > f.size)
+      break;
+    if (kind == 1 && len >= 4) {
+      u32 sid = get_u32(p);
+      if (sid >= strs.size())
+        strs.resize(sid + 1);
+      strs[sid].assign((const char*) p + 4, len - 4);
+    }
+    else if (kind == 2 && len >= msg_fixed) {
+      rec r;
+      r.time = get_u64(p);
+      r.off  = pos + 5;
+      r.id   = get_u32(p + 12);
+      r.sev  = p[32];
+      if (!recs.empty() && r.time < recs.back().time)
+        sorted = false;
+      recs.push_back(r);
+    }
+    pos += 5 + len;
+  }
+
+  if (!sorted) {
+    struct by_time {
+      bool operator()(const rec &a, const rec &b) const { return a.time < b.time; }
+    };
+    std::stable_sort(recs.begin(), recs.end(), by_time());
+  }
+
+  u32 n = recs.size();
+  times.resize(n);
+  offsets.resize(n);
+  ids.resize(n);
+  sevs.resize(n);
+  for (u32 i = 0; i < n; i++) {
+    times[i]   = recs[i].time;
+    offsets[i] = recs[i].off;
+    ids[i]     = recs[i].id;
+    sevs[i]    = recs[i].sev;
+  }
+
+  // Counting sort by id keeps each id slice in time order
+  id_start.assign(strs.size() + 1, 0);
+  for (u32 i = 0; i < n; i++)
+    if (ids[i] < strs.size())
+      id_start[ids[i] + 1]++;
+  for (size_t s = 1; s < id_start.size(); s++)
+    id_start[s] += id_start[s - 1];
+  by_id.resize(id_start.back());
+  std::vector<u32> fill(id_start.begin(), id_start.end() - 1);
+  for (u32 i = 0; i < n; i++)
+    if (ids[i] < strs.size())
+      by_id[fill[ids[i]]++] = i;
+
+  return true;
+}
+
+
+template <class T>
+static void write_vec(FILE *fp, const std::vector<T> &v)
+{
+  if (!v.empty())
+    fwrite(&v[0], sizeof(T), v.size(), fp);
+}
+
+template <class T>
+static const u8 *read_vec(const u8 *p, const u8 *end, std::vector<T> &v, size_t n)
+{
+  if (p == 0 || (size_t) (end - p) < n * sizeof(T))
+    return 0;
+  v.resize(n);
+  if (n)
+    memcpy(&v[0], p, n * sizeof(T));
+  return p + n * sizeof(T);
+}
+
+
+bool report_index::save(const std::string &path) const
+{
+  FILE *fp = fopen(path.c_str(), "wb");
+  u32 hdr[4];
+  u64 size = stream_size;
+
+  if (fp == NULL)
+    return false;
+
+  hdr[0] = index_version;
+  hdr[1] = num_records();
+  hdr[2] = strs.size();
+  hdr[3] = by_id.size();
+  fwrite(index_magic, 1, 8, fp);
+  fwrite(hdr, sizeof(u32), 4, fp);
+  fwrite(&size, sizeof(u64), 1, fp);
+  write_vec(fp, times);
+  write_vec(fp, offsets);
+  write_vec(fp, ids);
+  write_vec(fp, sevs);
+  write_vec(fp, by_id);
+  write_vec(fp, id_start);
+  for (size_t s = 0; s < strs.size(); s++) {
+    u32 len = strs[s].size();
+    fwrite(&len, sizeof(u32), 1, fp);
+    fwrite(strs[s].data(), 1, len, fp);
+  }
+  return fclose(fp) == 0;
+}
+
+
+bool report_index::load(const mapped_file &f, u64 expected_stream_size)
+{
+  const u8 *p = f.data, *end = f.data + f.size;
+  u32 hdr[4];
+
+  if (f.size < 32 || memcmp(p, index_magic, 8) != 0)
+    return false;
+  memcpy(hdr, p + 8, sizeof(hdr));
+  memcpy(&stream_size, p + 24, sizeof(u64));
+  if (hdr[0] != index_version || stream_size != expected_stream_size)
+    return false;
+
+  p += 32;
+  p = read_vec(p, end, times, hdr[1]);
+  p = read_vec(p, end, offsets, hdr[1]);
+  p = read_vec(p, end, ids, hdr[1]);
+  p = read_vec(p, end, sevs, hdr[1]);
+  p = read_vec(p, end, by_id, hdr[3]);
+  p = read_vec(p, end, id_start, hdr[2] + 1);
+  if (p == 0)
+    return false;
+
+  strs.resize(hdr[2]);
+  for (u32 s = 0; s < hdr[2]; s++) {
+    u32 len;
+    if (end - p < 4)
+      return false;
+    memcpy(&len, p, 4);
+    p += 4;
+    if ((u32) (end - p) < len)
+      return false;
+    strs[s].assign((const char*) p, len);
+    p += len;
+  }
+  return true;
+}
+
+
+int report_index::find_str(const std::string &s) const
+{
+  for (size_t i = 0; i < strs.size(); i++)
+    if (strs[i] == s)
+      return i;
+  return -1;
+}
+
+
+//------------------------------------------------------------------------------
+// Command-line front end
+//------------------------------------------------------------------------------
+
+static int usage()
+{
+  fprintf(stderr,
+    "usage: uvm_report_index index   <stream>\n"
+    "       uvm_report_index summary <stream>\n"
+    "       uvm_report_index query   <stream> [-from <t>] [-to <t>] [-id <id>]\n"
+    "                                [-severity <sev>] [-first] [-count] [-limit <n>]\n");
+  return 2;
+}
+
+
+static int parse_severity(std::string s)
+{
+  for (size_t i = 0; i < s.size(); i++)
+    s[i] = toupper((unsigned char) s[i]);
+  if (s.compare(0, 4, "UVM_") != 0)
+    s = "UVM_" + s;
+  for (int i = 0; i < 4; i++)
+    if (s == sev_names[i])
+      return i;
+  return -1;
+}
+
+
+// Opens the index for ~stream~, rebuilding it if missing or stale.
+static bool open_index(const std::string &stream, mapped_file &sf,
+                       report_index &idx, bool force_rebuild)
+{
+  std::string idx_path = stream + ".idx";
+  struct stat st;
+
+  if (!sf.open(stream)) {
+    fprintf(stderr, "uvm_report_index: unable to open '%s'\n", stream.c_str());
+    return false;
+  }
+
+  if (!force_rebuild && stat(idx_path.c_str(), &st) == 0 && st.st_mtime >= sf.mtime) {
+    mapped_file xf;
+    if (xf.open(idx_path) && idx.load(xf, sf.size))
+      return true;
+  }
+
+  if (!idx.build(sf))
+    return false;
+  if (!idx.save(idx_path))
+    fprintf(stderr, "uvm_report_index: warning: unable to write '%s'\n",
+            idx_path.c_str());
+  return true;
+}
+
+
+static void print_record(const mapped_file &sf, const report_index &idx, u32 r)
+{
+  const u8 *p = sf.data + idx.offsets[r];
+  u32 len  = get_u32(p - 4);
+  u32 name = get_u32(p + 8);
+  u32 file = get_u32(p + 16);
+  u32 line = get_u32(p + 20);
+  u8  sev  = p[32];
+  const char *sev_name = sev < 4 ? sev_names[sev] : "UVM_?";
+  const std::string empty;
+  const std::string &n = name < idx.strs.size() ? idx.strs[name] : empty;
+  const std::string &f = file < idx.strs.size() ? idx.strs[file] : empty;
+  const std::string &i = idx.ids[r] < idx.strs.size() ? idx.strs[idx.ids[r]] : empty;
+
+  printf("%s", sev_name);
+  if (!f.empty())
+    printf(" %s(%u)", f.c_str(), line);
+  printf(" @ %llu", idx.times[r]);
+  if (!n.empty())
+    printf(": %s", n.c_str());
+  printf(" [%s] %.*s\n", i.c_str(), (int) (len - msg_fixed), (const char*) p + msg_fixed);
+}
+
+
+static int do_summary(const mapped_file &sf, const report_index &idx)
+{
+  u32 sev_count[4] = { 0, 0, 0, 0 };
+  int first_err = -1;
+
+  for (u32 r = 0; r < idx.num_records(); r++) {
+    if (idx.sevs[r] < 4)
+      sev_count[idx.sevs[r]]++;
+    if (first_err < 0 && idx.sevs[r] >= 2)
+      first_err = r;
+  }
+
+  printf("** Report counts by severity\n");
+  for (int s = 0; s < 4; s++)
+    printf("%s :%5u\n", sev_names[s], sev_count[s]);
+  printf("** Report counts by id\n");
+  for (size_t s = 0; s + 1 < idx.id_start.size(); s++)
+    if (idx.id_start[s + 1] != idx.id_start[s])
+      printf("[%s] %5u\n", idx.strs[s].c_str(), idx.id_start[s + 1] - idx.id_start[s]);
+  if (first_err >= 0) {
+    printf("** First error\n");
+    print_record(sf, idx, first_err);
+  }
+  return 0;
+}
+
+
+static int do_query(const mapped_file &sf, const report_index &idx,
+                    int argc, char **argv)
+{
+  u64  from = 0, to = ~0ULL;
+  int  min_sev = 0;
+  long limit = -1;
+  bool count_only = false;
+  std::string id;
+  bool by_id = false;
+
+  for (int a = 0; a < argc; a++) {
+    std::string opt = argv[a];
+    bool has_val = a + 1 < argc;
+    if (opt == "-from" && has_val)
+      from = strtoull(argv[++a], 0, 0);
+    else if (opt == "-to" && has_val)
+      to = strtoull(argv[++a], 0, 0);
+    else if (opt == "-id" && has_val) {
+      id = argv[++a];
+      by_id = true;
+    }
+    else if (opt == "-severity" && has_val) {
+      min_sev = parse_severity(argv[++a]);
+      if (min_sev < 0) {
+        fprintf(stderr, "uvm_report_index: unknown severity '%s'\n", argv[a]);
+        return 2;
+      }
+    }
+    else if (opt == "-limit" && has_val)
+      limit = strtol(argv[++a], 0, 0);
+    else if (opt == "-first")
+      limit = 1;
+    else if (opt == "-count")
+      count_only = true;
+    else
+      return usage();
+  }
+
+  // Candidate set: either the whole time-ordered column or one id slice,
+  // narrowed to [from,to] by binary search in both cases.
+  const u32 *cand;
+  u32 ncand;
+  if (by_id) {
+    int sid = idx.find_str(id);
+    if (sid < 0) {
+      if (count_only)
+        printf("0\n");
+      return 0;
+    }
+    cand  = idx.by_id.empty() ? 0 : &idx.by_id[idx.id_start[sid]];
+    ncand = idx.id_start[sid + 1] - idx.id_start[sid];
+  }
+  else {
+    cand  = 0;
+    ncand = idx.num_records();
+  }
+
+  struct time_of {
+    const report_index &idx; const u32 *cand;
+    u64 operator()(u32 i) const { return idx.times[cand ? cand[i] : i]; }
+  } t = { idx, cand };
+
+  u32 lo = 0, hi = ncand;
+  while (lo < hi) {
+    u32 mid = lo + (hi - lo) / 2;
+    if (t(mid) < from) lo = mid + 1; else hi = mid;
+  }
+
+  u64 matched = 0;
+  for (u32 i = lo; i < ncand && t(i) <= to; i++) {
+    u32 r = cand ? cand[i] : i;
+    if (idx.sevs[r] < min_sev)
+      continue;
+    matched++;
+    if (!count_only)
+      print_record(sf, idx, r);
+    if (limit >= 0 && matched >= (u64) limit)
+      break;
+  }
+
+  if (count_only)
+    printf("%llu\n", matched);
+  return 0;
+}
+
+
+int main(int argc, char **argv)
+{
+  mapped_file  sf;
+  report_index idx;
+
+  if (argc < 3)
+    return usage();
+
+  std::string cmd = argv[1];
+  if (cmd != "index" && cmd != "summary" && cmd != "query")
+    return usage();
+
+  if (!open_index(argv[2], sf, idx, cmd == "index"))
+    return 1;
+
+  if (cmd == "index") {
+    printf("%u records, %u strings\n", idx.num_records(), (u32) idx.strs.size());
+    return 0;
+  }
+  if (cmd == "summary")
+    return do_summary(sf, idx);
+  return do_query(sf, idx, argc - 3, argv + 3);
+}
@@ -0,0 +1,232 @@
+//----------------------------------------------------------------------
+//   Copyright 2007-2011 Mentor Graphics Corporation
+//   Copyright 2007-2011 Cadence Design Systems, Inc.
+//   Copyright 2010-2011 Synopsys, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+//
+// uvm_rsrc_audit_read
+//
+// Prints the resource get records of an audit file written by
+// uvm_resource_pool::set_audit_file (see src/dpi/uvm_rsrc_audit.c for
+// the file layout):
+//
+//   uvm_rsrc_audit_read [-summary] [-failed] <file>
+//
+// By default every record is printed in the format used by
+// uvm_resource_pool::dump_get_records. With -summary, the number of
+// gets is printed per name and scope instead. With -failed, only the
+// gets that did not find a resource are considered.
+//
+// Build:
+//
+//   gcc -O2 -o uvm_rsrc_audit_read uvm_rsrc_audit_read.c
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define UVM_RSRC_AUDIT_KIND_STR  1
+#define UVM_RSRC_AUDIT_KIND_GET  2
+#define UVM_RSRC_AUDIT_GET_SIZE  20
+#define UVM_RSRC_AUDIT_NO_RSRC   0xffffffffu
+
+
+typedef struct uvm_rsa_count_s {
+  unsigned int name_sid;
+  unsigned int scope_sid;
+  unsigned long long gets;
+  unsigned long long failed;
+} uvm_rsa_count_t;
+
+
+static unsigned int uvm_rsa_u32(const unsigned char *p)
+{
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int) p[3] << 24);
+}
+
+
+static unsigned long long uvm_rsa_u64(const unsigned char *p)
+{
+  return uvm_rsa_u32(p) | ((unsigned long long) uvm_rsa_u32(p + 4) << 32);
+}
+
+
+static int uvm_rsa_cmp_key(const void *a, const void *b)
+{
+  const uvm_rsa_count_t *x = (const uvm_rsa_count_t*) a;
+  const uvm_rsa_count_t *y = (const uvm_rsa_count_t*) b;
+  if (x->name_sid != y->name_sid)
+    return (x->name_sid < y->name_sid) ? -1 : 1;
+  return (x->scope_sid < y->scope_sid) ? -1 : (x->scope_sid > y->scope_sid);
+}
+
+
+static int uvm_rsa_cmp_count(const void *a, const void *b)
+{
+  const uvm_rsa_count_t *x = (const uvm_rsa_count_t*) a;
+  const uvm_rsa_count_t *y = (const uvm_rsa_count_t*) b;
+  if (x->gets != y->gets)
+    return (x->gets < y->gets) ? 1 : -1;
+  if (x->name_sid != y->name_sid)
+    return (x->name_sid < y->name_sid) ? -1 : 1;
+  return (x->scope_sid < y->scope_sid) ? -1 : (x->scope_sid > y->scope_sid);
+}
+
+
+int main(int argc, char **argv)
+{
+  int summary = 0, failed_only = 0, a;
+  const char *path = NULL;
+  FILE *fp;
+  unsigned char *data;
+  long size;
+  size_t pos;
+  char **strs = NULL;
+  unsigned int num_strs = 0;
+  uvm_rsa_count_t *counts = NULL;
+  size_t num_counts = 0, cap_counts = 0, i;
+  unsigned long long num_gets = 0;
+
+  for (a = 1; a < argc; a++) {
+    if (strcmp(argv[a], "-summary") == 0)
+      summary = 1;
+    else if (strcmp(argv[a], "-failed") == 0)
+      failed_only = 1;
+    else
+      path = argv[a];
+  }
+  if (path == NULL) {
+    fprintf(stderr, "usage: uvm_rsrc_audit_read [-summary] [-failed] <file>\n");
+    return 2;
+  }
+
+  fp = fopen(path, "rb");
+  if (fp == NULL) {
+    fprintf(stderr, "uvm_rsrc_audit_read: unable to open '%s'\n", path);
+    return 1;
+  }
+  fseek(fp, 0, SEEK_END);
+  size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  data = (unsigned char*) malloc(size > 0 ? size : 1);
+  if (size < 16 || fread(data, 1, size, fp) != (size_t) size ||
+      memcmp(data, "UVMRSAU", 8) != 0) {
+    fprintf(stderr, "uvm_rsrc_audit_read: '%s' is not a resource audit file\n", path);
+    fclose(fp);
+    return 1;
+  }
+  fclose(fp);
+
+  for (pos = 16; pos + 5 <= (size_t) size; ) {
+    unsigned int kind = data[pos];
+    unsigned int len = uvm_rsa_u32(data + pos + 1);
+    const unsigned char *p = data + pos + 5;
+
+    if (pos + 5 + len > (size_t) size) {
+      fprintf(stderr, "uvm_rsrc_audit_read: truncated record at offset %lu\n",
+              (unsigned long) pos);
+      break;
+    }
+    pos += 5 + len;
+
+    if (kind == UVM_RSRC_AUDIT_KIND_STR && len >= 4) {
+      unsigned int sid = uvm_rsa_u32(p);
+      if (sid >= num_strs) {
+        unsigned int n = sid + 1 > 2 * num_strs ? sid + 1 : 2 * num_strs;
+        strs = (char**) realloc(strs, n * sizeof(char*));
+        memset(strs + num_strs, 0, (n - num_strs) * sizeof(char*));
+        num_strs = n;
+      }
+      free(strs[sid]);
+      strs[sid] = (char*) malloc(len - 4 + 1);
+      memcpy(strs[sid], p + 4, len - 4);
+      strs[sid][len - 4] = '\0';
+    }
+    else if (kind == UVM_RSRC_AUDIT_KIND_GET && len >= UVM_RSRC_AUDIT_GET_SIZE) {
+      unsigned long long t = uvm_rsa_u64(p);
+      unsigned int name_sid  = uvm_rsa_u32(p + 8);
+      unsigned int scope_sid = uvm_rsa_u32(p + 12);
+      unsigned int rsrc_sid  = uvm_rsa_u32(p + 16);
+      int success = (rsrc_sid != UVM_RSRC_AUDIT_NO_RSRC);
+      const char *name  = (name_sid < num_strs && strs[name_sid]) ? strs[name_sid] : "?";
+      const char *scope = (scope_sid < num_strs && strs[scope_sid]) ? strs[scope_sid] : "?";
+
+      if (failed_only && success)
+        continue;
+      num_gets++;
+
+      if (!summary) {
+        printf("get: name=%s  scope=%s  %s @ %llu\n", name, scope,
+               success ? "success" : "fail", t);
+        continue;
+      }
+
+      // Consecutive gets of the same name and scope share an entry;
+      // the others are merged after sorting
+      if (num_counts == 0 || counts[num_counts-1].name_sid != name_sid ||
+          counts[num_counts-1].scope_sid != scope_sid) {
+        if (num_counts == cap_counts) {
+          cap_counts = cap_counts ? 2 * cap_counts : 256;
+          counts = (uvm_rsa_count_t*) realloc(counts, cap_counts * sizeof(uvm_rsa_count_t));
+        }
+        counts[num_counts].name_sid  = name_sid;
+        counts[num_counts].scope_sid = scope_sid;
+        counts[num_counts].gets      = 0;
+        counts[num_counts].failed    = 0;
+        num_counts++;
+      }
+      counts[num_counts-1].gets++;
+      if (!success)
+        counts[num_counts-1].failed++;
+    }
+  }
+
+  if (summary) {
+    size_t n = 0;
+    qsort(counts, num_counts, sizeof(uvm_rsa_count_t), uvm_rsa_cmp_key);
+    for (i = 0; i < num_counts; i++) {
+      if (n > 0 && uvm_rsa_cmp_key(&counts[n-1], &counts[i]) == 0) {
+        counts[n-1].gets   += counts[i].gets;
+        counts[n-1].failed += counts[i].failed;
+      }
+      else
+        counts[n++] = counts[i];
+    }
+    num_counts = n;
+    qsort(counts, num_counts, sizeof(uvm_rsa_count_t), uvm_rsa_cmp_count);
+    printf("%12s %12s  name / scope\n", "gets", "failed");
+    for (i = 0; i < num_counts; i++) {
+      const char *name  = (counts[i].name_sid < num_strs && strs[counts[i].name_sid])
+                          ? strs[counts[i].name_sid] : "?";
+      const char *scope = (counts[i].scope_sid < num_strs && strs[counts[i].scope_sid])
+                          ? strs[counts[i].scope_sid] : "?";
+      printf("%12llu %12llu  %s  %s\n", counts[i].gets, counts[i].failed, name, scope);
+    }
+    printf("%llu gets\n", num_gets);
+  }
+
+  for (i = 0; i < num_strs; i++)
+    free(strs[i]);
+  free(strs);
+  free(counts);
+  free(data);
+  return 0;
+}
@@ -0,0 +1,119 @@
+//----------------------------------------------------------------------
+//   Copyright 2007-2011 Mentor Graphics Corporation
+//   Copyright 2007-2011 Cadence Design Systems, Inc.
+//   Copyright 2010-2011 Synopsys, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+//
+// uvm_tr_db_bench
+//
+// Microbenchmark for the native transaction recording database. Drives
+// the same entry points uvm_dpi_recorder calls through DPI (one stream,
+// begin_tr, a set of attributes, end_tr, free_tr per transaction), then
+// reads the database back, and reports transactions per second for both.
+//
+// Build (any simulator's vpi_user.h will do, since only vpi_printf is
+// used and it is provided below):
+//
+//   gcc -O2 -I<sim>/include -I../src/dpi -o uvm_tr_db_bench uvm_tr_db_bench.c
+//
+// Usage:
+//
+//   uvm_tr_db_bench [<num_transactions> [<db>]]
+//
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "vpi_user.h"
+
+PLI_INT32 vpi_printf(PLI_BYTE8 *fmt, ...)
+{
+  va_list ap;
+  int n;
+  va_start(ap, fmt);
+  n = vprintf(fmt, ap);
+  va_end(ap);
+  return n;
+}
+
+#include "uvm_tr_db.c"
+
+#define UVM_TR_DB_READ_NO_MAIN
+#include "uvm_tr_db_read.c"
+
+
+static double uvm_tr_db_bench_now()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+int main(int argc, char **argv)
+{
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  const char *db = argc > 2 ? argv[2] : "uvm_tr_db_bench";
+  static const char *fields[] = { "addr", "data", "size", "kind",
+                                  "burst", "id", "resp", "prot" };
+  s_vpi_vecval value[32];
+  uvm_tr_db_reader_t *r;
+  uvm_tr_db_attr_t attr;
+  unsigned long long num_attrs = 0;
+  double t0, t1, t2;
+  int stream, i, f;
+
+  if (!uvm_tr_db_open(db))
+    return 1;
+
+  t0 = uvm_tr_db_bench_now();
+  stream = uvm_tr_db_create_stream("bus", "TVM", "uvm_test_top.env.agent.driver");
+  for (i = 0; i < n; i++) {
+    int h = uvm_tr_db_begin_tr("Begin_No_Parent, Link", stream, "req", "", "", 10ULL * i);
+    for (f = 0; f < 8; f++) {
+      value[0].aval = i * 8 + f;
+      value[0].bval = 0;
+      uvm_tr_db_set_attribute(h, fields[f], value, 2, 32);
+    }
+    uvm_tr_db_set_attribute_string(h, "name", "req");
+    uvm_tr_db_end_tr(h, 10ULL * i + 5);
+    uvm_tr_db_free_tr(h, 10ULL * i + 5);
+  }
+  uvm_tr_db_close();
+  t1 = uvm_tr_db_bench_now();
+
+  r = uvm_tr_db_reader_open(db);
+  if (r == NULL)
+    return 1;
+  while (uvm_tr_db_reader_next_attr(r, &attr))
+    num_attrs++;
+  t2 = uvm_tr_db_bench_now();
+
+  if (uvm_tr_db_reader_num_trs(r) != (unsigned int) n || num_attrs != 9ULL * n) {
+    printf("uvm_tr_db_bench: read back %u transactions, %llu attributes; expected %d, %llu\n",
+           uvm_tr_db_reader_num_trs(r), num_attrs, n, 9ULL * n);
+    return 1;
+  }
+  uvm_tr_db_reader_close(r);
+
+  printf("record: %d transactions in %.3f s, %.0f tr/s\n", n, t1 - t0, n / (t1 - t0));
+  printf("read  : %d transactions in %.3f s, %.0f tr/s\n", n, t2 - t1, n / (t2 - t1));
+  return 0;
+}
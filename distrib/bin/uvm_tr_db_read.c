@@ -0,0 +1,512 @@
+//----------------------------------------------------------------------
+//   Copyright 2007-2011 Mentor Graphics Corporation
+//   Copyright 2007-2011 Cadence Design Systems, Inc.
+//   Copyright 2010-2011 Synopsys, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+//
+// uvm_tr_db_read
+//
+// Reader library for the transaction recording database written by
+// uvm_dpi_recorder (see src/dpi/uvm_tr_db.c for the file layout), and a
+// small command-line front end:
+//
+//   uvm_tr_db_read [-dump] [-from <time>] <db>
+//
+// Build:
+//
+//   gcc -O2 -o uvm_tr_db_read uvm_tr_db_read.c
+//
+// To use only the library, compile with -DUVM_TR_DB_READ_NO_MAIN and
+// include or link this file.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+typedef struct uvm_tr_db_tr_s {
+  unsigned int tr_id;
+  unsigned int stream_id;
+  unsigned long long begin_time;
+  unsigned long long end_time;
+  int ended;
+  const char *type;
+  const char *name;
+  const char *label;
+  const char *desc;
+} uvm_tr_db_tr_t;
+
+
+typedef struct uvm_tr_db_attr_s {
+  unsigned int tr_id;            // 0 for a stream attribute
+  const char *name;
+  int is_string;
+  int radix;
+  int numbits;
+  const unsigned char *words;    // numeric: aval/bval u32 pairs, little-endian
+  const char *str;               // string: not NUL-terminated
+  unsigned int str_len;
+} uvm_tr_db_attr_t;
+
+
+typedef struct uvm_tr_db_stream_s {
+  const char *name;
+  const char *type;
+  const char *scope;
+  unsigned int num_attrs;
+  const char **attr_names;
+} uvm_tr_db_stream_t;
+
+
+typedef struct uvm_tr_db_reader_s {
+  unsigned char *files[5];
+  size_t sizes[5];
+
+  const char **strs;
+  unsigned int num_strs;
+
+  uvm_tr_db_stream_t *streams;   // indexed by stream_id - 1
+  unsigned int num_streams;
+
+  uvm_tr_db_tr_t *trs;           // indexed by tr_id - 1, in begin order
+  unsigned int num_trs;
+
+  size_t attr_pos;
+} uvm_tr_db_reader_t;
+
+
+enum { UVM_TR_DB_R_STR, UVM_TR_DB_R_STRM, UVM_TR_DB_R_TR,
+       UVM_TR_DB_R_ATTR, UVM_TR_DB_R_IDX };
+
+static const char *uvm_tr_db_r_suffix[5] = { ".str", ".strm", ".tr", ".attr", ".idx" };
+
+
+static unsigned int uvm_tr_db_r_u32(const unsigned char *p)
+{
+  return (unsigned int) p[0] | ((unsigned int) p[1] << 8) |
+         ((unsigned int) p[2] << 16) | ((unsigned int) p[3] << 24);
+}
+
+
+static unsigned long long uvm_tr_db_r_u64(const unsigned char *p)
+{
+  return (unsigned long long) uvm_tr_db_r_u32(p) |
+         ((unsigned long long) uvm_tr_db_r_u32(p + 4) << 32);
+}
+
+
+static const char *uvm_tr_db_r_str(uvm_tr_db_reader_t *r, unsigned int sid)
+{
+  return (sid < r->num_strs && r->strs[sid] != NULL) ? r->strs[sid] : "";
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_reader_close
+//--------------------------------------------------------------------
+
+void uvm_tr_db_reader_close(uvm_tr_db_reader_t *r)
+{
+  unsigned int i;
+  if (r == NULL)
+    return;
+  for (i = 0; i < 5; i++)
+    free(r->files[i]);
+  for (i = 0; i < r->num_strs; i++)
+    free((void*) r->strs[i]);
+  free(r->strs);
+  for (i = 0; i < r->num_streams; i++)
+    free(r->streams[i].attr_names);
+  free(r->streams);
+  free(r->trs);
+  free(r);
+}
+
+
+static void uvm_tr_db_r_add_attr(uvm_tr_db_reader_t *r, unsigned int stream_id,
+                                 unsigned int attr_id, const char *name)
+{
+  uvm_tr_db_stream_t *s;
+  if (stream_id == 0 || stream_id > r->num_streams)
+    return;
+  s = &r->streams[stream_id - 1];
+  if (attr_id >= s->num_attrs) {
+    unsigned int n = attr_id + 1;
+    s->attr_names = (const char**) realloc(s->attr_names, n * sizeof(char*));
+    memset(s->attr_names + s->num_attrs, 0, (n - s->num_attrs) * sizeof(char*));
+    s->num_attrs = n;
+  }
+  s->attr_names[attr_id] = name;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_reader_open
+//
+// Loads the database named 'db'. Returns NULL if any of its files
+// cannot be read or is not a recording database.
+//--------------------------------------------------------------------
+
+uvm_tr_db_reader_t *uvm_tr_db_reader_open(const char *db)
+{
+  uvm_tr_db_reader_t *r = (uvm_tr_db_reader_t*) calloc(1, sizeof(uvm_tr_db_reader_t));
+  size_t len = strlen(db), pos;
+  char *path = (char*) malloc(len + 8);
+  unsigned int i;
+
+  for (i = 0; i < 5; i++) {
+    FILE *fp;
+    long sz;
+    memcpy(path, db, len);
+    strcpy(path + len, uvm_tr_db_r_suffix[i]);
+    fp = fopen(path, "rb");
+    if (fp == NULL) {
+      fprintf(stderr, "uvm_tr_db_read: unable to open '%s'\n", path);
+      free(path);
+      uvm_tr_db_reader_close(r);
+      return NULL;
+    }
+    fseek(fp, 0, SEEK_END);
+    sz = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    r->files[i] = (unsigned char*) malloc(sz > 0 ? sz : 1);
+    r->sizes[i] = fread(r->files[i], 1, sz, fp);
+    fclose(fp);
+    if (r->sizes[i] < 16 || memcmp(r->files[i], "UVMTRDB", 8) != 0 ||
+        uvm_tr_db_r_u32(r->files[i] + 8) != 1) {
+      fprintf(stderr, "uvm_tr_db_read: '%s' is not a recording database\n", path);
+      free(path);
+      uvm_tr_db_reader_close(r);
+      return NULL;
+    }
+  }
+  free(path);
+
+  // Strings
+  for (pos = 16; pos + 8 <= r->sizes[UVM_TR_DB_R_STR]; ) {
+    const unsigned char *p = r->files[UVM_TR_DB_R_STR] + pos;
+    unsigned int sid = uvm_tr_db_r_u32(p), slen = uvm_tr_db_r_u32(p + 4);
+    char *s;
+    if (pos + 8 + slen > r->sizes[UVM_TR_DB_R_STR])
+      break;
+    if (sid >= r->num_strs) {
+      unsigned int n = sid + 1 > 2 * r->num_strs ? sid + 1 : 2 * r->num_strs;
+      r->strs = (const char**) realloc(r->strs, n * sizeof(char*));
+      memset(r->strs + r->num_strs, 0, (n - r->num_strs) * sizeof(char*));
+      r->num_strs = n;
+    }
+    s = (char*) malloc(slen + 1);
+    memcpy(s, p + 8, slen);
+    s[slen] = '\0';
+    r->strs[sid] = s;
+    pos += 8 + slen;
+  }
+
+  // Streams
+  r->num_streams = (r->sizes[UVM_TR_DB_R_STRM] - 16) / 16;
+  r->streams = (uvm_tr_db_stream_t*) calloc(r->num_streams + 1, sizeof(uvm_tr_db_stream_t));
+  for (i = 0; i < r->num_streams; i++) {
+    const unsigned char *p = r->files[UVM_TR_DB_R_STRM] + 16 + 16 * i;
+    unsigned int id = uvm_tr_db_r_u32(p);
+    if (id == 0 || id > r->num_streams)
+      continue;
+    r->streams[id - 1].name  = uvm_tr_db_r_str(r, uvm_tr_db_r_u32(p + 4));
+    r->streams[id - 1].type  = uvm_tr_db_r_str(r, uvm_tr_db_r_u32(p + 8));
+    r->streams[id - 1].scope = uvm_tr_db_r_str(r, uvm_tr_db_r_u32(p + 12));
+  }
+
+  // Transactions: tr_ids are allocated sequentially from 1 at begin_tr
+  {
+    size_t rows = (r->sizes[UVM_TR_DB_R_TR] - 16) / 40, n = 0, cap = 0;
+    for (i = 0; i < rows; i++) {
+      const unsigned char *p = r->files[UVM_TR_DB_R_TR] + 16 + 40 * (size_t) i;
+      unsigned int kind = uvm_tr_db_r_u32(p), id = uvm_tr_db_r_u32(p + 4);
+      if (kind == 1) {
+        uvm_tr_db_tr_t *t;
+        if (id > cap) {
+          cap = id > 2 * cap ? id : 2 * cap;
+          r->trs = (uvm_tr_db_tr_t*) realloc(r->trs, cap * sizeof(uvm_tr_db_tr_t));
+        }
+        if (id > n) {
+          memset(r->trs + n, 0, (id - n) * sizeof(uvm_tr_db_tr_t));
+          n = id;
+        }
+        t = &r->trs[id - 1];
+        t->tr_id      = id;
+        t->stream_id  = uvm_tr_db_r_u32(p + 8);
+        t->begin_time = uvm_tr_db_r_u64(p + 16);
+        t->type  = uvm_tr_db_r_str(r, uvm_tr_db_r_u32(p + 24));
+        t->name  = uvm_tr_db_r_str(r, uvm_tr_db_r_u32(p + 28));
+        t->label = uvm_tr_db_r_str(r, uvm_tr_db_r_u32(p + 32));
+        t->desc  = uvm_tr_db_r_str(r, uvm_tr_db_r_u32(p + 36));
+      }
+      else if (kind == 2 && id >= 1 && id <= n) {
+        r->trs[id - 1].end_time = uvm_tr_db_r_u64(p + 16);
+        r->trs[id - 1].ended = 1;
+      }
+    }
+    r->num_trs = n;
+  }
+
+  // Attribute dictionaries; values are scanned with next_attr
+  for (pos = 16; pos < r->sizes[UVM_TR_DB_R_ATTR]; ) {
+    const unsigned char *p = r->files[UVM_TR_DB_R_ATTR] + pos;
+    size_t avail = r->sizes[UVM_TR_DB_R_ATTR] - pos;
+    if (p[0] == 1 && avail >= 13) {
+      uvm_tr_db_r_add_attr(r, uvm_tr_db_r_u32(p + 1), uvm_tr_db_r_u32(p + 5),
+                           uvm_tr_db_r_str(r, uvm_tr_db_r_u32(p + 9)));
+      pos += 13;
+    }
+    else if (p[0] == 2 && avail >= 14)
+      pos += 14 + 8 * (size_t) ((uvm_tr_db_r_u32(p + 10) + 31) / 32);
+    else if (p[0] == 3 && avail >= 13)
+      pos += 13 + uvm_tr_db_r_u32(p + 9);
+    else
+      break;
+  }
+  r->attr_pos = 16;
+
+  return r;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_reader_num_trs / get_tr / get_stream
+//--------------------------------------------------------------------
+
+unsigned int uvm_tr_db_reader_num_trs(uvm_tr_db_reader_t *r)
+{
+  return r->num_trs;
+}
+
+const uvm_tr_db_tr_t *uvm_tr_db_reader_get_tr(uvm_tr_db_reader_t *r, unsigned int tr_id)
+{
+  if (tr_id == 0 || tr_id > r->num_trs)
+    return NULL;
+  return &r->trs[tr_id - 1];
+}
+
+const uvm_tr_db_stream_t *uvm_tr_db_reader_get_stream(uvm_tr_db_reader_t *r,
+                                                      unsigned int stream_id)
+{
+  if (stream_id == 0 || stream_id > r->num_streams)
+    return NULL;
+  return &r->streams[stream_id - 1];
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_reader_find_time
+//
+// Returns the tr_id of the first transaction that began at or after
+// 't', or 0 if there is none. Uses the index blocks to narrow the
+// search to one interval.
+//--------------------------------------------------------------------
+
+unsigned int uvm_tr_db_reader_find_time(uvm_tr_db_reader_t *r, unsigned long long t)
+{
+  size_t nblk = (r->sizes[UVM_TR_DB_R_IDX] - 16) / 24;
+  const unsigned char *idx = r->files[UVM_TR_DB_R_IDX] + 16;
+  size_t lo = 0, hi = nblk;
+  unsigned int id;
+
+  // Last block whose first_time <= t
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (uvm_tr_db_r_u64(idx + 24 * mid + 8) <= t) lo = mid + 1; else hi = mid;
+  }
+  id = (lo == 0) ? 1 : uvm_tr_db_r_u32(idx + 24 * (lo - 1));
+
+  for (; id <= r->num_trs; id++)
+    if (r->trs[id - 1].tr_id != 0 && r->trs[id - 1].begin_time >= t)
+      return id;
+  return 0;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_reader_next_attr
+//
+// Returns the next attribute value in recording order in 'a'.
+// Returns 0 at the end of the attribute column.
+//--------------------------------------------------------------------
+
+int uvm_tr_db_reader_next_attr(uvm_tr_db_reader_t *r, uvm_tr_db_attr_t *a)
+{
+  while (r->attr_pos < r->sizes[UVM_TR_DB_R_ATTR]) {
+    const unsigned char *p = r->files[UVM_TR_DB_R_ATTR] + r->attr_pos;
+    size_t avail = r->sizes[UVM_TR_DB_R_ATTR] - r->attr_pos;
+    unsigned int stream_id, attr_id;
+    const uvm_tr_db_stream_t *s;
+
+    if (p[0] == 1 && avail >= 13) {
+      r->attr_pos += 13;
+      continue;
+    }
+    if ((p[0] != 2 || avail < 14) && (p[0] != 3 || avail < 13))
+      return 0;
+
+    memset(a, 0, sizeof(*a));
+    a->tr_id = uvm_tr_db_r_u32(p + 1);
+    attr_id  = uvm_tr_db_r_u32(p + 5);
+    if (p[0] == 2) {
+      a->radix   = p[9];
+      a->numbits = uvm_tr_db_r_u32(p + 10);
+      a->words   = p + 14;
+      r->attr_pos += 14 + 8 * (size_t) ((a->numbits + 31) / 32);
+    }
+    else {
+      a->is_string = 1;
+      a->str_len = uvm_tr_db_r_u32(p + 9);
+      a->str     = (const char*) p + 13;
+      r->attr_pos += 13 + a->str_len;
+    }
+    if (r->attr_pos > r->sizes[UVM_TR_DB_R_ATTR])
+      return 0;
+
+    stream_id = (a->tr_id >= 1 && a->tr_id <= r->num_trs) ? r->trs[a->tr_id - 1].stream_id : 0;
+    s = uvm_tr_db_reader_get_stream(r, stream_id);
+    a->name = (s != NULL && attr_id < s->num_attrs && s->attr_names[attr_id] != NULL)
+              ? s->attr_names[attr_id] : "";
+    return 1;
+  }
+  return 0;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_reader_rewind
+//
+// Restarts the attribute scan at the beginning of the column.
+//--------------------------------------------------------------------
+
+void uvm_tr_db_reader_rewind(uvm_tr_db_reader_t *r)
+{
+  r->attr_pos = 16;
+}
+
+
+#ifndef UVM_TR_DB_READ_NO_MAIN
+
+static void uvm_tr_db_r_print_attr(const uvm_tr_db_attr_t *a)
+{
+  printf("  %s = ", a->name);
+  if (a->is_string)
+    printf("\"%.*s\"\n", (int) a->str_len, a->str);
+  else {
+    int w = (a->numbits + 31) / 32;
+    printf("'h");
+    if (w == 0)
+      printf("0");
+    while (w-- > 0)
+      printf(w == (a->numbits + 31) / 32 - 1 ? "%x" : "%08x",
+             uvm_tr_db_r_u32(a->words + 8 * w));
+    printf("\n");
+  }
+}
+
+
+// Orders by transaction, then by position in the attribute column
+static int uvm_tr_db_r_cmp_attr(const void *x, const void *y)
+{
+  const uvm_tr_db_attr_t *a = (const uvm_tr_db_attr_t*) x;
+  const uvm_tr_db_attr_t *b = (const uvm_tr_db_attr_t*) y;
+  const void *pa = a->is_string ? (const void*) a->str : (const void*) a->words;
+  const void *pb = b->is_string ? (const void*) b->str : (const void*) b->words;
+  if (a->tr_id != b->tr_id)
+    return a->tr_id < b->tr_id ? -1 : 1;
+  return (pa < pb) ? -1 : (pa > pb);
+}
+
+
+int main(int argc, char **argv)
+{
+  int dump = 0, a;
+  unsigned long long from = 0;
+  unsigned int id, first = 1;
+  const char *db = NULL;
+  uvm_tr_db_reader_t *r;
+  uvm_tr_db_attr_t attr;
+  unsigned long long num_attrs = 0;
+
+  for (a = 1; a < argc; a++) {
+    if (strcmp(argv[a], "-dump") == 0)
+      dump = 1;
+    else if (strcmp(argv[a], "-from") == 0 && a + 1 < argc)
+      from = strtoull(argv[++a], NULL, 0);
+    else
+      db = argv[a];
+  }
+  if (db == NULL) {
+    fprintf(stderr, "usage: uvm_tr_db_read [-dump] [-from <time>] <db>\n");
+    return 2;
+  }
+
+  r = uvm_tr_db_reader_open(db);
+  if (r == NULL)
+    return 1;
+
+  if (from != 0) {
+    first = uvm_tr_db_reader_find_time(r, from);
+    if (first == 0)
+      first = r->num_trs + 1;
+  }
+
+  if (dump) {
+    // Transactions may overlap, so group attribute values by transaction
+    // before printing them in begin order.
+    uvm_tr_db_attr_t *attrs = NULL;
+    size_t n = 0, cap = 0, k = 0;
+    while (uvm_tr_db_reader_next_attr(r, &attr)) {
+      if (n == cap) {
+        cap = cap ? 2 * cap : 1024;
+        attrs = (uvm_tr_db_attr_t*) realloc(attrs, cap * sizeof(uvm_tr_db_attr_t));
+      }
+      attrs[n++] = attr;
+    }
+    qsort(attrs, n, sizeof(uvm_tr_db_attr_t), uvm_tr_db_r_cmp_attr);
+
+    for (id = first; id <= r->num_trs; id++) {
+      const uvm_tr_db_tr_t *t = &r->trs[id - 1];
+      const uvm_tr_db_stream_t *s = uvm_tr_db_reader_get_stream(r, t->stream_id);
+      if (t->tr_id == 0)
+        continue;
+      printf("TR %u %s.%s \"%s\" type=%s @ %llu..", t->tr_id,
+             s ? s->scope : "", s ? s->name : "", t->name, t->type, t->begin_time);
+      if (t->ended) printf("%llu\n", t->end_time); else printf("?\n");
+      while (k < n && attrs[k].tr_id < id)
+        k++;
+      for (; k < n && attrs[k].tr_id == id; k++)
+        uvm_tr_db_r_print_attr(&attrs[k]);
+    }
+    free(attrs);
+  }
+  else {
+    while (uvm_tr_db_reader_next_attr(r, &attr))
+      num_attrs++;
+    printf("%u streams, %u transactions, %llu attribute values\n",
+           r->num_streams, r->num_trs, num_attrs);
+  }
+
+  uvm_tr_db_reader_close(r);
+  return 0;
+}
+
+#endif
@@ -0,0 +1,63 @@
+//----------------------------------------------------------------------
+//   Copyright 2007-2011 Mentor Graphics Corporation
+//   Copyright 2007-2011 Cadence Design Systems, Inc.
+//   Copyright 2010-2011 Synopsys, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+#include <string.h>
+#include "svdpi.h"
+#include "vpi_user.h"
+
+
+//--------------------------------------------------------------------
+// uvm_mem_equal
+//
+// Returns 1 if the first 'n' elements of the int unsigned open arrays
+// 'a' and 'b' are identical, 0 otherwise. Used by uvm_comparer to
+// compare packed object images.
+//--------------------------------------------------------------------
+
+int uvm_mem_equal(const svOpenArrayHandle a, const svOpenArrayHandle b, int n)
+{
+  const unsigned int *pa, *pb;
+  int i, la, lb;
+
+  if (n <= 0)
+    return 1;
+  if (svSize(a, 1) < n || svSize(b, 1) < n) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_mem_equal: %0d elements requested, arrays hold %0d and %0d\n",
+               n, svSize(a, 1), svSize(b, 1));
+    return 0;
+  }
+
+  pa = (const unsigned int*) svGetArrayPtr(a);
+  pb = (const unsigned int*) svGetArrayPtr(b);
+  if (pa != NULL && pb != NULL)
+    return memcmp(pa, pb, n * sizeof(unsigned int)) == 0;
+
+  // The simulator does not store the arrays contiguously
+  la = svLow(a, 1);
+  lb = svLow(b, 1);
+  for (i = 0; i < n; i++)
+    if (*(const unsigned int*) svGetArrElemPtr1(a, la + i) !=
+        *(const unsigned int*) svGetArrElemPtr1(b, lb + i))
+      return 0;
+  return 1;
+}
+
@@ -30,9 +30,19 @@
 extern "C" {
 #endif
 
+#include "uvm_dpi_profile.c"
 #include "uvm_regex.cc"
 #include "uvm_hdl.c"
 #include "uvm_svcmd_dpi.c"
+#include "uvm_report_stream.c"
+#include "uvm_tr_db.c"
+#include "uvm_str_buf.c"
+#include "uvm_compare.c"
+#include "uvm_clock.c"
+#include "uvm_native_fifo.c"
+#include "uvm_rsrc_audit.c"
+#include "uvm_rsrc_snap.c"
+#include "uvm_refmodel.c"
 
 #ifdef __cplusplus
 }
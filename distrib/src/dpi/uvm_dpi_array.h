@@ -0,0 +1,71 @@
+/*----------------------------------------------------------------------
+ *   Copyright 2007-2011 Mentor Graphics Corporation
+ *   Copyright 2007-2011 Cadence Design Systems, Inc.
+ *   Copyright 2010-2011 Synopsys, Inc.
+ *   All Rights Reserved Worldwide
+ *
+ *   Licensed under the Apache License, Version 2.0 (the
+ *   "License"); you may not use this file except in
+ *   compliance with the License.  You may obtain a copy of
+ *   the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in
+ *   writing, software distributed under the License is
+ *   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ *   CONDITIONS OF ANY KIND, either express or implied.  See
+ *   the License for the specific language governing
+ *   permissions and limitations under the License.
+ *----------------------------------------------------------------------*/
+
+
+/*
+ * Word copies between int unsigned open arrays and native buffers.
+ *
+ * svGetArrayPtr() returns NULL when the simulator does not store the
+ * open array contiguously; the elements are then copied one at a time
+ * with svGetArrElemPtr1(), starting at the array's low index.
+ */
+
+#ifndef UVM_DPI_ARRAY_H
+#define UVM_DPI_ARRAY_H
+
+#include <string.h>
+#include "svdpi.h"
+
+
+// Copies the first 'n' words of the open array 'a' into 'dst'
+
+static inline void uvm_dpi_array_get(const svOpenArrayHandle a, unsigned int *dst, int n)
+{
+  const unsigned int *p = (const unsigned int*) svGetArrayPtr(a);
+  int i, lo;
+
+  if (p != NULL) {
+    memcpy(dst, p, (size_t) n * sizeof(unsigned int));
+    return;
+  }
+  lo = svLow(a, 1);
+  for (i = 0; i < n; i++)
+    dst[i] = *(const unsigned int*) svGetArrElemPtr1(a, lo + i);
+}
+
+
+// Copies 'n' words from 'src' into the first 'n' words of the open array 'a'
+
+static inline void uvm_dpi_array_put(const svOpenArrayHandle a, const unsigned int *src, int n)
+{
+  unsigned int *p = (unsigned int*) svGetArrayPtr(a);
+  int i, lo;
+
+  if (p != NULL) {
+    memcpy(p, src, (size_t) n * sizeof(unsigned int));
+    return;
+  }
+  lo = svLow(a, 1);
+  for (i = 0; i < n; i++)
+    *(unsigned int*) svGetArrElemPtr1(a, lo + i) = src[i];
+}
+
+#endif /* UVM_DPI_ARRAY_H */
@@ -0,0 +1,192 @@
+//----------------------------------------------------------------------
+//   Copyright 2007-2011 Mentor Graphics Corporation
+//   Copyright 2007-2011 Cadence Design Systems, Inc.
+//   Copyright 2010-2011 Synopsys, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+#include <string.h>
+#include "uvm_dpi_profile.h"
+
+
+/*
+ * UVM DPI profile.
+ *
+ * For each profiled entry point (see uvm_dpi_profile.h), counts the
+ * calls and accumulates their duration, measured with the monotonic
+ * clock of uvm_wallclock_ns, into a total, a maximum and a histogram
+ * of decades from "under 100ns" to "100ms and over".
+ */
+
+#define UVM_DPI_PROF_BUCKETS 8
+
+typedef struct uvm_dpi_prof_s {
+  unsigned long long calls;
+  unsigned long long total_ns;
+  unsigned long long max_ns;
+  unsigned long long hist[UVM_DPI_PROF_BUCKETS];
+} uvm_dpi_prof_t;
+
+int uvm_dpi_prof_enabled = 0;
+
+static uvm_dpi_prof_t uvm_dpi_prof[UVM_DPI_PROF_NUM];
+
+static const char *uvm_dpi_prof_names[UVM_DPI_PROF_NUM] = {
+  "uvm_re_match",
+  "uvm_re_match:regcomp",
+  "uvm_glob_to_re",
+  "uvm_hdl_check_path",
+  "uvm_hdl_read",
+  "uvm_hdl_deposit",
+  "uvm_hdl_force",
+  "uvm_hdl_release",
+  "dpi_regcomp",
+  "dpi_regexec",
+  "uvm_hdl_inject",
+  "uvm_refmodel_collect",
+  "uvm_hdl_check_paths",
+  "uvm_hdl_inject_add_batch"
+};
+
+static const char *uvm_dpi_prof_bucket_names[UVM_DPI_PROF_BUCKETS] = {
+  "<100ns", "<1us", "<10us", "<100us", "<1ms", "<10ms", "<100ms", ">=100ms"
+};
+
+
+void uvm_dpi_prof_add(int id, unsigned long long t0)
+{
+  unsigned long long ns = uvm_wallclock_ns() - t0;
+  unsigned long long limit = 100;
+  uvm_dpi_prof_t *p = &uvm_dpi_prof[id];
+  int b;
+
+  p->calls++;
+  p->total_ns += ns;
+  if (ns > p->max_ns)
+    p->max_ns = ns;
+  for (b = 0; b < UVM_DPI_PROF_BUCKETS - 1 && ns >= limit; b++)
+    limit *= 10;
+  p->hist[b]++;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_dpi_profile_enable
+//
+// Enables (on != 0) or disables the profile. Counts are kept.
+//--------------------------------------------------------------------
+
+void uvm_dpi_profile_enable(int on)
+{
+  uvm_dpi_prof_enabled = (on != 0);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_dpi_profile_is_enabled
+//--------------------------------------------------------------------
+
+int uvm_dpi_profile_is_enabled()
+{
+  return uvm_dpi_prof_enabled;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_dpi_profile_reset
+//
+// Clears all counts.
+//--------------------------------------------------------------------
+
+void uvm_dpi_profile_reset()
+{
+  memset(uvm_dpi_prof, 0, sizeof(uvm_dpi_prof));
+}
+
+
+//--------------------------------------------------------------------
+// uvm_dpi_profile_num / uvm_dpi_profile_num_buckets
+//
+// Number of profiled entry points and of histogram buckets.
+//--------------------------------------------------------------------
+
+int uvm_dpi_profile_num()
+{
+  return UVM_DPI_PROF_NUM;
+}
+
+int uvm_dpi_profile_num_buckets()
+{
+  return UVM_DPI_PROF_BUCKETS;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_dpi_profile_name / uvm_dpi_profile_bucket_name
+//
+// Name of entry point 'id' and of histogram bucket 'b', or "" if out
+// of range.
+//--------------------------------------------------------------------
+
+const char *uvm_dpi_profile_name(int id)
+{
+  if (id < 0 || id >= UVM_DPI_PROF_NUM)
+    return "";
+  return uvm_dpi_prof_names[id];
+}
+
+const char *uvm_dpi_profile_bucket_name(int b)
+{
+  if (b < 0 || b >= UVM_DPI_PROF_BUCKETS)
+    return "";
+  return uvm_dpi_prof_bucket_names[b];
+}
+
+
+//--------------------------------------------------------------------
+// uvm_dpi_profile_calls / _total_ns / _max_ns / _bucket
+//
+// Counts of entry point 'id', or 0 if out of range.
+//--------------------------------------------------------------------
+
+unsigned long long uvm_dpi_profile_calls(int id)
+{
+  if (id < 0 || id >= UVM_DPI_PROF_NUM)
+    return 0;
+  return uvm_dpi_prof[id].calls;
+}
+
+unsigned long long uvm_dpi_profile_total_ns(int id)
+{
+  if (id < 0 || id >= UVM_DPI_PROF_NUM)
+    return 0;
+  return uvm_dpi_prof[id].total_ns;
+}
+
+unsigned long long uvm_dpi_profile_max_ns(int id)
+{
+  if (id < 0 || id >= UVM_DPI_PROF_NUM)
+    return 0;
+  return uvm_dpi_prof[id].max_ns;
+}
+
+unsigned long long uvm_dpi_profile_bucket(int id, int b)
+{
+  if (id < 0 || id >= UVM_DPI_PROF_NUM || b < 0 || b >= UVM_DPI_PROF_BUCKETS)
+    return 0;
+  return uvm_dpi_prof[id].hist[b];
+}
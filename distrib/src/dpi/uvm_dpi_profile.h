@@ -0,0 +1,70 @@
+/*----------------------------------------------------------------------
+ *   Copyright 2007-2011 Mentor Graphics Corporation
+ *   Copyright 2007-2011 Cadence Design Systems, Inc.
+ *   Copyright 2010-2011 Synopsys, Inc.
+ *   All Rights Reserved Worldwide
+ *
+ *   Licensed under the Apache License, Version 2.0 (the
+ *   "License"); you may not use this file except in
+ *   compliance with the License.  You may obtain a copy of
+ *   the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in
+ *   writing, software distributed under the License is
+ *   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ *   CONDITIONS OF ANY KIND, either express or implied.  See
+ *   the License for the specific language governing
+ *   permissions and limitations under the License.
+ *----------------------------------------------------------------------*/
+
+/*
+ * Hot-path counters and timers of the UVM DPI library.
+ *
+ * Each profiled entry point brackets its work with UVM_DPI_PROF_BEGIN
+ * and UVM_DPI_PROF_END. When profiling is disabled, which is the
+ * default, the cost is the test of a single global flag.
+ */
+
+#ifndef UVM_DPI_PROFILE_H
+#define UVM_DPI_PROFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+  UVM_DPI_PROF_RE_MATCH,
+  UVM_DPI_PROF_RE_COMPILE,
+  UVM_DPI_PROF_GLOB_TO_RE,
+  UVM_DPI_PROF_HDL_CHECK_PATH,
+  UVM_DPI_PROF_HDL_READ,
+  UVM_DPI_PROF_HDL_DEPOSIT,
+  UVM_DPI_PROF_HDL_FORCE,
+  UVM_DPI_PROF_HDL_RELEASE,
+  UVM_DPI_PROF_REGCOMP,
+  UVM_DPI_PROF_REGEXEC,
+  UVM_DPI_PROF_HDL_INJECT,
+  UVM_DPI_PROF_REFMODEL_COLLECT,
+  UVM_DPI_PROF_HDL_CHECK_PATHS,
+  UVM_DPI_PROF_HDL_INJECT_BATCH,
+  UVM_DPI_PROF_NUM
+};
+
+extern int uvm_dpi_prof_enabled;
+
+unsigned long long uvm_wallclock_ns();
+void uvm_dpi_prof_add(int id, unsigned long long t0);
+
+#define UVM_DPI_PROF_BEGIN \
+  unsigned long long uvm_dpi_prof_t0 = uvm_dpi_prof_enabled ? uvm_wallclock_ns() : 0
+
+#define UVM_DPI_PROF_END(id) \
+  if (uvm_dpi_prof_enabled && uvm_dpi_prof_t0 != 0) uvm_dpi_prof_add(id, uvm_dpi_prof_t0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UVM_DPI_PROFILE_H */
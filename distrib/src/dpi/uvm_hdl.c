@@ -22,7 +22,9 @@
 #include "vpi_user.h"
 #include "veriuser.h"
 #include "svdpi.h"
+#include "uvm_dpi_profile.h"
 #include <malloc.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -325,6 +327,7 @@ static int uvm_hdl_get_vlog(char *path, p_vpi_vecval value, PLI_INT32 flag)
 int uvm_hdl_check_path(char *path)
 {
   vpiHandle r;
+  UVM_DPI_PROF_BEGIN;
 
   #ifdef QUESTA
   if (!strncmp(path,"$root.",6)) {
@@ -334,10 +337,329 @@ int uvm_hdl_check_path(char *path)
   #endif
   r = vpi_handle_by_name(path, 0);
 
+  UVM_DPI_PROF_END(UVM_DPI_PROF_HDL_CHECK_PATH);
   if(r == 0)
       return 0;
-  else 
+#ifndef VCS
+  vpi_release_handle(r);
+#endif
+  return 1;
+}
+
+
+/*
+ * Batch check of HDL paths, e.g. of all the backdoor paths of a block.
+ *
+ * The paths are sorted by scope, i.e. by what precedes their last '.',
+ * so each scope is looked up once and its signals are looked up
+ * relative to it. When many paths are checked in a scope, its signals
+ * are listed once with vpi_iterate instead, unless it has many more
+ * signals than paths to check. The paths of a scope that is not found
+ * are not looked up. Every handle is released.
+ */
+
+#define UVM_HDL_CHECK_ITERATE_MIN   16  // paths to check to list a scope
+#define UVM_HDL_CHECK_ITERATE_RATIO 8   // signals listed per path, at most
+
+typedef struct uvm_hdl_chk_path_s {
+  const char *path;
+  int idx;
+  int scope_len;        // 0 if the path is looked up as a whole
+} uvm_hdl_chk_path_t;
+
+typedef struct uvm_hdl_chk_sig_s {
+  char *name;
+  int size;
+} uvm_hdl_chk_sig_t;
+
+
+// Length of the scope of 'path': up to its last '.' outside of a
+// select, 0 if it has none or has escaped identifiers
+static int uvm_hdl_chk_scope_len(const char *path)
+{
+  int depth = 0, len = 0, i;
+
+  for (i = 0; path[i] != '\0'; i++) {
+    if (path[i] == '\\')
+      return 0;
+    if (path[i] == '[')
+      depth++;
+    else if (path[i] == ']')
+      depth--;
+    else if (path[i] == '.' && depth == 0)
+      len = i;
+  }
+  return len;
+}
+
+
+static int uvm_hdl_chk_path_cmp(const void *a, const void *b)
+{
+  const uvm_hdl_chk_path_t *x = (const uvm_hdl_chk_path_t*) a;
+  const uvm_hdl_chk_path_t *y = (const uvm_hdl_chk_path_t*) b;
+  int n = (x->scope_len < y->scope_len) ? x->scope_len : y->scope_len;
+  int c = memcmp(x->path, y->path, n);
+
+  if (c != 0)
+    return c;
+  if (x->scope_len != y->scope_len)
+    return x->scope_len - y->scope_len;
+  return x->idx - y->idx;
+}
+
+
+static int uvm_hdl_chk_sig_cmp(const void *a, const void *b)
+{
+  return strcmp(((const uvm_hdl_chk_sig_t*) a)->name,
+                ((const uvm_hdl_chk_sig_t*) b)->name);
+}
+
+
+static int uvm_hdl_chk_sig_find(const void *key, const void *b)
+{
+  return strcmp((const char*) key, ((const uvm_hdl_chk_sig_t*) b)->name);
+}
+
+
+/*
+ * Returns the value of the 'bound' (vpiLeftRange or vpiRightRange) of
+ * the declared range of signal 'r', or 'dflt' if it has none.
+ */
+static int uvm_hdl_chk_bound(vpiHandle r, PLI_INT32 bound, int dflt)
+{
+  s_vpi_value value_s = { vpiIntVal, { 0 } };
+  vpiHandle b = vpi_handle(bound, r);
+
+  if (b == 0)
+    return dflt;
+  vpi_get_value(b, &value_s);
+#ifndef VCS
+  vpi_release_handle(b);
+#endif
+  return value_s.value.integer;
+}
+
+
+/*
+ * Looks 'name' up relative to 'scope', or as a full path if 'scope' is
+ * 0, and sets 'size' to its width. Part-selects are not found by name
+ * by every simulator: the selected signal is looked up instead, and
+ * the part-select must be within its declared range, in the same
+ * direction. Returns 1 if found, 0 otherwise.
+ */
+static int uvm_hdl_chk_lookup(const char *name, vpiHandle scope, int *size)
+{
+  vpiHandle r;
+  const char *sel;
+  char *base;
+  int len, msb, lsb, left, right, base_size, ok;
+
+  r = vpi_handle_by_name((PLI_BYTE8*) name, scope);
+  if (r != 0) {
+    *size = vpi_get(vpiSize, r);
+#ifndef VCS
+    vpi_release_handle(r);
+#endif
     return 1;
+  }
+
+  len = strlen(name);
+  sel = strrchr(name, '[');
+  if (len == 0 || name[len-1] != ']' || sel == NULL || sel == name ||
+      sscanf(sel, "[%d:%d]", &msb, &lsb) != 2)
+    return 0;
+  base = (char*) malloc(sel - name + 1);
+  if (base == NULL)
+    return 0;
+  memcpy(base, name, sel - name);
+  base[sel - name] = '\0';
+  r = vpi_handle_by_name(base, scope);
+  free(base);
+  if (r == 0)
+    return 0;
+  base_size = vpi_get(vpiSize, r);
+  left = uvm_hdl_chk_bound(r, vpiLeftRange, base_size - 1);
+  right = uvm_hdl_chk_bound(r, vpiRightRange, 0);
+#ifndef VCS
+  vpi_release_handle(r);
+#endif
+  *size = (msb > lsb) ? msb - lsb + 1 : lsb - msb + 1;
+  if (left >= right)
+    ok = (msb >= lsb && msb <= left && lsb >= right);
+  else
+    ok = (msb <= lsb && msb >= left && lsb <= right);
+  return ok && *size <= base_size;
+}
+
+
+/*
+ * Lists the signals of 'scope', sorted by name, into 'sigs'.
+ * Returns their number, or 0 if there are more than 'max'.
+ */
+static int uvm_hdl_chk_list(vpiHandle scope, int max,
+                            uvm_hdl_chk_sig_t **sigs, int *max_sigs)
+{
+  static const PLI_INT32 types[] = { vpiNet, vpiReg, vpiVariables,
+                                     vpiNetArray, vpiRegArray };
+  int num = 0, t, i;
+
+  for (t = 0; t < (int) (sizeof(types) / sizeof(types[0])); t++) {
+    vpiHandle it, s;
+
+    it = vpi_iterate(types[t], scope);
+    if (it == 0)
+      continue;
+    while ((s = vpi_scan(it)) != 0) {
+      const char *name = vpi_get_str(vpiName, s);
+
+      if (num == *max_sigs && num < max) {
+        int n = (*max_sigs == 0) ? 64 : 2 * *max_sigs;
+        uvm_hdl_chk_sig_t *p = (uvm_hdl_chk_sig_t*)
+          realloc(*sigs, n * sizeof(uvm_hdl_chk_sig_t));
+        if (p != NULL) {
+          *sigs = p;
+          *max_sigs = n;
+        }
+      }
+      if (num == max || num == *max_sigs || name == NULL ||
+          ((*sigs)[num].name = (char*) malloc(strlen(name) + 1)) == NULL) {
+        // Too many signals, or out of memory: look the paths up by name
+#ifndef VCS
+        vpi_release_handle(s);
+        vpi_release_handle(it);
+#endif
+        for (i = 0; i < num; i++)
+          free((*sigs)[i].name);
+        return 0;
+      }
+      strcpy((*sigs)[num].name, name);
+      (*sigs)[num].size = vpi_get(vpiSize, s);
+      num++;
+#ifndef VCS
+      vpi_release_handle(s);
+#endif
+    }
+  }
+  qsort(*sigs, num, sizeof(uvm_hdl_chk_sig_t), uvm_hdl_chk_sig_cmp);
+  return num;
+}
+
+
+/*
+ * Checks all the HDL 'paths' at once. 'status' is set to 1 for each
+ * path that is found, 0 otherwise, and 'widths' to the width of the
+ * signals found. Returns the number of paths found, -1 on error.
+ */
+int uvm_hdl_check_paths(const svOpenArrayHandle paths,
+                        const svOpenArrayHandle status,
+                        const svOpenArrayHandle widths)
+{
+  uvm_hdl_chk_path_t *p;
+  uvm_hdl_chk_sig_t *sigs = NULL;
+  char *scope_name = NULL;
+  int n, lo, status_lo, widths_lo, max_sigs = 0, max_scope = 0;
+  int found = 0, i, j, k;
+  UVM_DPI_PROF_BEGIN;
+
+  n = svSize(paths, 1);
+  if (svSize(status, 1) < n || svSize(widths, 1) < n) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_hdl_check_paths: %0d paths checked, arrays hold %0d statuses and %0d widths\n",
+               n, svSize(status, 1), svSize(widths, 1));
+    return -1;
+  }
+  if (n <= 0)
+    return 0;
+
+  p = (uvm_hdl_chk_path_t*) malloc(n * sizeof(uvm_hdl_chk_path_t));
+  if (p == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_hdl_check_paths: internal memory allocation error\n");
+    return -1;
+  }
+  lo = svLow(paths, 1);
+  status_lo = svLow(status, 1);
+  widths_lo = svLow(widths, 1);
+  for (i = 0; i < n; i++) {
+    const char *path = *(const char**) svGetArrElemPtr1(paths, lo + i);
+    if (path == NULL)
+      path = "";
+    #ifdef QUESTA
+    if (!strncmp(path,"$root.",6))
+      path += 6;
+    #endif
+    p[i].path = path;
+    p[i].idx = i;
+    p[i].scope_len = uvm_hdl_chk_scope_len(path);
+  }
+  qsort(p, n, sizeof(uvm_hdl_chk_path_t), uvm_hdl_chk_path_cmp);
+
+  for (i = 0; i < n; i = j) {
+    vpiHandle scope = 0;
+    int len = p[i].scope_len, num_sigs = 0;
+
+    j = i + 1;
+    if (len > 0) {
+      while (j < n && p[j].scope_len == len && !memcmp(p[j].path, p[i].path, len))
+        j++;
+      if (len + 1 > max_scope) {
+        free(scope_name);
+        max_scope = 2 * len + 1;
+        scope_name = (char*) malloc(max_scope);
+        if (scope_name == NULL) {
+          vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_hdl_check_paths: internal memory allocation error\n");
+          free(p);
+          free(sigs);
+          return -1;
+        }
+      }
+      memcpy(scope_name, p[i].path, len);
+      scope_name[len] = '\0';
+      scope = vpi_handle_by_name(scope_name, 0);
+      if (scope != 0 && j - i >= UVM_HDL_CHECK_ITERATE_MIN)
+        num_sigs = uvm_hdl_chk_list(scope, (j - i) * UVM_HDL_CHECK_ITERATE_RATIO,
+                                    &sigs, &max_sigs);
+    }
+
+    for (k = i; k < j; k++) {
+      int ok = 0, size = 0;
+
+      if (len == 0)
+        ok = uvm_hdl_chk_lookup(p[k].path, 0, &size);
+      else if (scope != 0) {
+        const char *leaf = p[k].path + len + 1;
+        uvm_hdl_chk_sig_t *s = NULL;
+
+        if (num_sigs > 0 && strchr(leaf, '[') == NULL)
+          s = (uvm_hdl_chk_sig_t*) bsearch(leaf, sigs, num_sigs, sizeof(uvm_hdl_chk_sig_t),
+                                           uvm_hdl_chk_sig_find);
+        if (s != NULL) {
+          ok = 1;
+          size = s->size;
+        }
+        else
+          ok = uvm_hdl_chk_lookup(leaf, scope, &size);
+        // Not every object is a scope, e.g. a structure
+        if (!ok)
+          ok = uvm_hdl_chk_lookup(p[k].path, 0, &size);
+      }
+
+      *(int*) svGetArrElemPtr1(status, status_lo + p[k].idx) = ok;
+      *(int*) svGetArrElemPtr1(widths, widths_lo + p[k].idx) = ok ? size : 0;
+      found += ok;
+    }
+
+    for (k = 0; k < num_sigs; k++)
+      free(sigs[k].name);
+#ifndef VCS
+    if (scope != 0)
+      vpi_release_handle(scope);
+#endif
+  }
+
+  free(p);
+  free(sigs);
+  free(scope_name);
+  UVM_DPI_PROF_END(UVM_DPI_PROF_HDL_CHECK_PATHS);
+  return found;
 }
 
 
@@ -347,7 +669,11 @@ int uvm_hdl_check_path(char *path)
  */
 int uvm_hdl_read(char *path, p_vpi_vecval value)
 {
-    return uvm_hdl_get_vlog(path, value, vpiNoDelay);
+    int ok;
+    UVM_DPI_PROF_BEGIN;
+    ok = uvm_hdl_get_vlog(path, value, vpiNoDelay);
+    UVM_DPI_PROF_END(UVM_DPI_PROF_HDL_READ);
+    return ok;
 }
 
 /*
@@ -356,7 +682,11 @@ int uvm_hdl_read(char *path, p_vpi_vecval value)
  */
 int uvm_hdl_deposit(char *path, p_vpi_vecval value)
 {
-    return uvm_hdl_set_vlog(path, value, vpiNoDelay);
+    int ok;
+    UVM_DPI_PROF_BEGIN;
+    ok = uvm_hdl_set_vlog(path, value, vpiNoDelay);
+    UVM_DPI_PROF_END(UVM_DPI_PROF_HDL_DEPOSIT);
+    return ok;
 }
 
 
@@ -366,7 +696,11 @@ int uvm_hdl_deposit(char *path, p_vpi_vecval value)
  */
 int uvm_hdl_force(char *path, p_vpi_vecval value)
 {
-    return uvm_hdl_set_vlog(path, value, vpiForceFlag);
+    int ok;
+    UVM_DPI_PROF_BEGIN;
+    ok = uvm_hdl_set_vlog(path, value, vpiForceFlag);
+    UVM_DPI_PROF_END(UVM_DPI_PROF_HDL_FORCE);
+    return ok;
 }
 
 
@@ -376,7 +710,11 @@ int uvm_hdl_force(char *path, p_vpi_vecval value)
  */
 int uvm_hdl_release_and_read(char *path, p_vpi_vecval value)
 {
-    return uvm_hdl_set_vlog(path, value, vpiReleaseFlag);
+    int ok;
+    UVM_DPI_PROF_BEGIN;
+    ok = uvm_hdl_set_vlog(path, value, vpiReleaseFlag);
+    UVM_DPI_PROF_END(UVM_DPI_PROF_HDL_RELEASE);
+    return ok;
 }
 
 /*
@@ -385,8 +723,750 @@ int uvm_hdl_release_and_read(char *path, p_vpi_vecval value)
  */
 int uvm_hdl_release(char *path)
 {
-  s_vpi_vecval value;
-  p_vpi_vecval valuep = &value;
-  return uvm_hdl_set_vlog(path, valuep, vpiReleaseFlag);
+  // The released value is written back, so the buffer must be able
+  // to hold the widest signal
+  static p_vpi_vecval valuep = NULL;
+  int ok;
+  if (valuep == NULL)
+    valuep = (p_vpi_vecval) calloc((uvm_hdl_max_width()-1)/32 + 1, sizeof(s_vpi_vecval));
+  UVM_DPI_PROF_BEGIN;
+  ok = uvm_hdl_set_vlog(path, valuep, vpiReleaseFlag);
+  UVM_DPI_PROF_END(UVM_DPI_PROF_HDL_RELEASE);
+  return ok;
+}
+
+
+
+/*
+ * UVM HDL injection scheduler.
+ *
+ * Schedules deposits, forces, releases and bit flips of HDL signals at
+ * given simulation times, e.g. for fault-injection campaigns, without
+ * any SystemVerilog process. The handle of a signal is looked up once,
+ * whatever the number of injections on it. The pending events are kept
+ * in a heap ordered by time: a single cbAtStartOfSimTime callback is
+ * registered for the earliest one, and the events of a time slot are
+ * applied from a cbReadWriteSynch callback, so bit flips and masked
+ * writes see the settled values of the slot. A timed force or flip
+ * schedules its own release. At a given time, releases are applied
+ * before forces, so back-to-back injections on a signal do not overlap.
+ *
+ * Times are in simulation time precision units, as used by VPI.
+ */
+
+#define UVM_HDL_INJECT_DEPOSIT 0
+#define UVM_HDL_INJECT_FORCE   1
+#define UVM_HDL_INJECT_RELEASE 2
+#define UVM_HDL_INJECT_FLIP    3
+
+#define UVM_HDL_INJECT_PENDING 0
+#define UVM_HDL_INJECT_ACTIVE  1
+#define UVM_HDL_INJECT_DONE    2
+
+typedef struct uvm_hdl_inj_sig_s {
+  char *path;
+  unsigned int hash;
+  vpiHandle handle;
+  int size;
+} uvm_hdl_inj_sig_t;
+
+typedef struct uvm_hdl_inj_s {
+  int sig;
+  int kind;
+  int state;
+  int masked;           // only the bits set in the mask are written
+  unsigned long long start;
+  unsigned long long duration;
+  unsigned long long applied_at;
+  unsigned long long released_at;
+  p_vpi_vecval value;   // value, then mask; the value applied once applied
+} uvm_hdl_inj_t;
+
+typedef struct uvm_hdl_inj_evt_s {
+  unsigned long long time;
+  unsigned int id;
+  unsigned int apply;   // 0 for a release, sorted first
+} uvm_hdl_inj_evt_t;
+
+static uvm_hdl_inj_sig_t *uvm_hdl_inj_sigs = NULL;
+static int uvm_hdl_inj_num_sigs = 0;
+static int uvm_hdl_inj_max_sigs = 0;
+static int *uvm_hdl_inj_sig_tbl = NULL;         // signal index + 1
+static unsigned int uvm_hdl_inj_sig_tbl_size = 0; // power of 2
+
+static uvm_hdl_inj_t *uvm_hdl_injs = NULL;
+static int uvm_hdl_inj_num = 0;
+static int uvm_hdl_inj_max = 0;
+static int uvm_hdl_inj_applied = 0;
+
+static uvm_hdl_inj_evt_t *uvm_hdl_inj_heap = NULL;
+static int uvm_hdl_inj_heap_num = 0;
+static int uvm_hdl_inj_heap_max = 0;
+
+static vpiHandle uvm_hdl_inj_time_cb = NULL;
+static unsigned long long uvm_hdl_inj_time_cb_at = 0;
+static int uvm_hdl_inj_rw_pending = 0;
+
+static int uvm_hdl_inj_max_words = 0;
+static p_vpi_vecval uvm_hdl_inj_buf = NULL;
+
+
+static unsigned int uvm_hdl_inj_hash(const char *s)
+{
+  unsigned int h = 2166136261u;
+  while (*s) {
+    h ^= (unsigned char)*s++;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+
+static unsigned long long uvm_hdl_inj_now()
+{
+  s_vpi_time time_s;
+  time_s.type = vpiSimTime;
+  vpi_get_time(NULL, &time_s);
+  return ((unsigned long long) time_s.high << 32) | time_s.low;
+}
+
+
+static int uvm_hdl_inj_words(int sig)
+{
+  return (uvm_hdl_inj_sigs[sig].size - 1) / 32 + 1;
+}
+
+
+static void uvm_hdl_inj_alloc_error()
+{
+  vpi_printf((PLI_BYTE8*) "UVM_ERROR: inject: internal memory allocation error\n");
+}
+
+
+/*
+ * Doubles the signal table. Reports an error and returns 0, leaving
+ * the table as it was, if it cannot be allocated.
+ */
+static int uvm_hdl_inj_sig_tbl_grow()
+{
+  unsigned int i, j, size;
+  int *tbl;
+
+  size = (uvm_hdl_inj_sig_tbl_size == 0) ? 1024 : 2 * uvm_hdl_inj_sig_tbl_size;
+  tbl = (int*) calloc(size, sizeof(int));
+  if (tbl == NULL) {
+    uvm_hdl_inj_alloc_error();
+    return 0;
+  }
+  for (i = 0; i < (unsigned int) uvm_hdl_inj_num_sigs; i++) {
+    j = uvm_hdl_inj_sigs[i].hash & (size - 1);
+    while (tbl[j] != 0)
+      j = (j + 1) & (size - 1);
+    tbl[j] = i + 1;
+  }
+  free(uvm_hdl_inj_sig_tbl);
+  uvm_hdl_inj_sig_tbl = tbl;
+  uvm_hdl_inj_sig_tbl_size = size;
+  return 1;
+}
+
+
+/*
+ * Returns the index of the signal at 'path', looking it up the
+ * first time it is seen, or -1 if it cannot be injected.
+ */
+static int uvm_hdl_inj_sig(char *path)
+{
+  unsigned int h, j;
+  vpiHandle r;
+  int size;
+  uvm_hdl_inj_sig_t *sig;
+
+  if (2 * (uvm_hdl_inj_num_sigs + 1) > (int) uvm_hdl_inj_sig_tbl_size &&
+      !uvm_hdl_inj_sig_tbl_grow())
+    return -1;
+
+  h = uvm_hdl_inj_hash(path);
+  j = h & (uvm_hdl_inj_sig_tbl_size - 1);
+  while (uvm_hdl_inj_sig_tbl[j] != 0) {
+    sig = &uvm_hdl_inj_sigs[uvm_hdl_inj_sig_tbl[j] - 1];
+    if (sig->hash == h && strcmp(sig->path, path) == 0)
+      return uvm_hdl_inj_sig_tbl[j] - 1;
+    j = (j + 1) & (uvm_hdl_inj_sig_tbl_size - 1);
+  }
+
+  #ifdef QUESTA
+  if (!strncmp(path,"$root.",6))
+    r = vpi_handle_by_name(path+6, 0);
+  else
+  #endif
+  r = vpi_handle_by_name(path, 0);
+
+  if (r == 0) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: inject: unable to locate hdl path (%s)\n",path);
+    vpi_printf((PLI_BYTE8*) " Either the name is incorrect, or you may not have PLI/ACC visibility to that name\n");
+    return -1;
+  }
+
+  if (uvm_hdl_inj_max_words == 0)
+    uvm_hdl_inj_max_words = (uvm_hdl_max_width() - 1) / 32 + 1;
+  size = vpi_get(vpiSize, r);
+  if (size <= 0 || (size - 1) / 32 + 1 > uvm_hdl_inj_max_words) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: inject: hdl path '%s' is %0d bits,\n",path,size);
+    vpi_printf((PLI_BYTE8*) " but the maximum size is %0d. You can increase the maximum\n",
+               32 * uvm_hdl_inj_max_words);
+    vpi_printf((PLI_BYTE8*) " via a compile-time flag: +define+UVM_HDL_MAX_WIDTH=<value>\n");
+#ifndef VCS
+    vpi_release_handle(r);
+#endif
+    return -1;
+  }
+
+  if (uvm_hdl_inj_num_sigs == uvm_hdl_inj_max_sigs) {
+    int max = (uvm_hdl_inj_max_sigs == 0) ? 256 : 2 * uvm_hdl_inj_max_sigs;
+    sig = (uvm_hdl_inj_sig_t*) realloc(uvm_hdl_inj_sigs, max * sizeof(uvm_hdl_inj_sig_t));
+    if (sig == NULL) {
+      uvm_hdl_inj_alloc_error();
+#ifndef VCS
+      vpi_release_handle(r);
+#endif
+      return -1;
+    }
+    uvm_hdl_inj_sigs = sig;
+    uvm_hdl_inj_max_sigs = max;
+  }
+  sig = &uvm_hdl_inj_sigs[uvm_hdl_inj_num_sigs];
+  sig->path = (char*) malloc(strlen(path) + 1);
+  if (sig->path == NULL) {
+    uvm_hdl_inj_alloc_error();
+#ifndef VCS
+    vpi_release_handle(r);
+#endif
+    return -1;
+  }
+  strcpy(sig->path, path);
+  sig->hash = h;
+  sig->handle = r;   // kept for the rest of the simulation
+  sig->size = size;
+  uvm_hdl_inj_sig_tbl[j] = ++uvm_hdl_inj_num_sigs;
+  return uvm_hdl_inj_num_sigs - 1;
+}
+
+
+static int uvm_hdl_inj_before(const uvm_hdl_inj_evt_t *a, const uvm_hdl_inj_evt_t *b)
+{
+  if (a->time != b->time)
+    return a->time < b->time;
+  if (a->apply != b->apply)
+    return a->apply < b->apply;
+  return a->id < b->id;
+}
+
+
+/*
+ * Adds an event to the heap. Returns 0 if the heap cannot grow.
+ */
+static int uvm_hdl_inj_push(unsigned long long time, int id, int apply)
+{
+  int i;
+  uvm_hdl_inj_evt_t evt;
+
+  if (uvm_hdl_inj_heap_num == uvm_hdl_inj_heap_max) {
+    int max = (uvm_hdl_inj_heap_max == 0) ? 1024 : 2 * uvm_hdl_inj_heap_max;
+    uvm_hdl_inj_evt_t *heap = (uvm_hdl_inj_evt_t*)
+      realloc(uvm_hdl_inj_heap, max * sizeof(uvm_hdl_inj_evt_t));
+    if (heap == NULL)
+      return 0;
+    uvm_hdl_inj_heap = heap;
+    uvm_hdl_inj_heap_max = max;
+  }
+  i = uvm_hdl_inj_heap_num++;
+  evt.time = time;
+  evt.id = id;
+  evt.apply = apply;
+  while (i > 0 && uvm_hdl_inj_before(&evt, &uvm_hdl_inj_heap[(i - 1) / 2])) {
+    uvm_hdl_inj_heap[i] = uvm_hdl_inj_heap[(i - 1) / 2];
+    i = (i - 1) / 2;
+  }
+  uvm_hdl_inj_heap[i] = evt;
+  return 1;
+}
+
+
+static uvm_hdl_inj_evt_t uvm_hdl_inj_pop()
+{
+  uvm_hdl_inj_evt_t top = uvm_hdl_inj_heap[0];
+  uvm_hdl_inj_evt_t last = uvm_hdl_inj_heap[--uvm_hdl_inj_heap_num];
+  int i = 0, c;
+
+  while ((c = 2 * i + 1) < uvm_hdl_inj_heap_num) {
+    if (c + 1 < uvm_hdl_inj_heap_num &&
+        uvm_hdl_inj_before(&uvm_hdl_inj_heap[c + 1], &uvm_hdl_inj_heap[c]))
+      c++;
+    if (!uvm_hdl_inj_before(&uvm_hdl_inj_heap[c], &last))
+      break;
+    uvm_hdl_inj_heap[i] = uvm_hdl_inj_heap[c];
+    i = c;
+  }
+  uvm_hdl_inj_heap[i] = last;
+  return top;
+}
+
+
+/*
+ * Applies injection 'id' at time 'now'.
+ */
+static void uvm_hdl_inj_apply(int id, unsigned long long now)
+{
+  uvm_hdl_inj_t *inj = &uvm_hdl_injs[id];
+  vpiHandle r = uvm_hdl_inj_sigs[inj->sig].handle;
+  int words = uvm_hdl_inj_words(inj->sig);
+  p_vpi_vecval mask = inj->value + words;
+  s_vpi_value value_s;
+  s_vpi_time  time_s = { vpiSimTime, 0, 0, 0.0 };
+  int i, force;
+
+  value_s.format = vpiVectorVal;
+  inj->applied_at = now;
+  uvm_hdl_inj_applied++;
+
+  if (inj->kind == UVM_HDL_INJECT_RELEASE) {
+    value_s.value.vector = uvm_hdl_inj_buf;
+    vpi_put_value(r, &value_s, &time_s, vpiReleaseFlag);
+    memcpy(inj->value, uvm_hdl_inj_buf, words * sizeof(s_vpi_vecval));
+    inj->state = UVM_HDL_INJECT_DONE;
+    return;
+  }
+
+  if (inj->kind == UVM_HDL_INJECT_FLIP || inj->masked) {
+    s_vpi_value cur_s;
+    cur_s.format = vpiVectorVal;
+    vpi_get_value(r, &cur_s);
+    for (i = 0; i < words; i++) {
+      s_vpi_vecval cur = cur_s.value.vector[i];
+      PLI_UINT32 m = mask[i].aval;
+      if (inj->kind == UVM_HDL_INJECT_FLIP) {
+        inj->value[i].aval = cur.aval ^ m;
+        inj->value[i].bval = cur.bval;
+      }
+      else {
+        inj->value[i].aval = (cur.aval & ~m) | (inj->value[i].aval & m);
+        inj->value[i].bval = (cur.bval & ~m) | (inj->value[i].bval & m);
+      }
+    }
+  }
+
+  force = (inj->kind == UVM_HDL_INJECT_FORCE ||
+           (inj->kind == UVM_HDL_INJECT_FLIP && inj->duration != 0));
+  value_s.value.vector = inj->value;
+  vpi_put_value(r, &value_s, &time_s, force ? vpiForceFlag : vpiNoDelay);
+
+  if (force && inj->duration != 0) {
+    inj->state = UVM_HDL_INJECT_ACTIVE;
+    if (!uvm_hdl_inj_push(now + inj->duration, id, 0)) {
+      uvm_hdl_inj_alloc_error();
+      vpi_printf((PLI_BYTE8*) " The force of '%s' will not be released\n",
+                 uvm_hdl_inj_sigs[inj->sig].path);
+      inj->state = UVM_HDL_INJECT_DONE;
+    }
+  }
+  else
+    inj->state = UVM_HDL_INJECT_DONE;
+}
+
+
+/*
+ * Ends the timed force of injection 'id' at time 'now'.
+ */
+static void uvm_hdl_inj_release(int id, unsigned long long now)
+{
+  uvm_hdl_inj_t *inj = &uvm_hdl_injs[id];
+  s_vpi_value value_s;
+  s_vpi_time  time_s = { vpiSimTime, 0, 0, 0.0 };
+
+  value_s.format = vpiVectorVal;
+  value_s.value.vector = uvm_hdl_inj_buf;
+  vpi_put_value(uvm_hdl_inj_sigs[inj->sig].handle, &value_s, &time_s, vpiReleaseFlag);
+  inj->released_at = now;
+  inj->state = UVM_HDL_INJECT_DONE;
+}
+
+
+static PLI_INT32 uvm_hdl_inj_rw_cb(p_cb_data cb);
+static PLI_INT32 uvm_hdl_inj_time_cb_rtn(p_cb_data cb);
+
+
+static vpiHandle uvm_hdl_inj_register(PLI_INT32 reason, unsigned long long time,
+                                      PLI_INT32 (*rtn)(p_cb_data))
+{
+  s_cb_data cb_s;
+  s_vpi_time time_s;
+
+  time_s.type = vpiSimTime;
+  time_s.high = (PLI_UINT32) (time >> 32);
+  time_s.low  = (PLI_UINT32) (time & 0xffffffffu);
+  time_s.real = 0.0;
+  cb_s.reason    = reason;
+  cb_s.cb_rtn    = rtn;
+  cb_s.obj       = NULL;
+  cb_s.time      = &time_s;
+  cb_s.value     = NULL;
+  cb_s.index     = 0;
+  cb_s.user_data = NULL;
+  return vpi_register_cb(&cb_s);
+}
+
+
+/*
+ * Requests a cbReadWriteSynch callback in the current time slot.
+ */
+static void uvm_hdl_inj_request_rw()
+{
+  vpiHandle cb;
+
+  if (uvm_hdl_inj_rw_pending)
+    return;
+  cb = uvm_hdl_inj_register(cbReadWriteSynch, 0, uvm_hdl_inj_rw_cb);
+  uvm_hdl_inj_rw_pending = 1;
+#ifndef VCS
+  vpi_release_handle(cb);
+#endif
+}
+
+
+static void uvm_hdl_inj_cancel_time_cb()
+{
+  if (uvm_hdl_inj_time_cb == NULL)
+    return;
+  vpi_remove_cb(uvm_hdl_inj_time_cb);
+  uvm_hdl_inj_time_cb = NULL;
+}
+
+
+/*
+ * Registers the callback of the earliest pending event, if needed.
+ */
+static void uvm_hdl_inj_schedule(unsigned long long now)
+{
+  unsigned long long next;
+
+  if (uvm_hdl_inj_heap_num == 0) {
+    uvm_hdl_inj_cancel_time_cb();
+    return;
+  }
+  next = uvm_hdl_inj_heap[0].time;
+  if (next <= now) {
+    uvm_hdl_inj_request_rw();
+    return;
+  }
+  if (uvm_hdl_inj_time_cb != NULL) {
+    if (uvm_hdl_inj_time_cb_at == next)
+      return;
+    uvm_hdl_inj_cancel_time_cb();
+  }
+  uvm_hdl_inj_time_cb = uvm_hdl_inj_register(cbAtStartOfSimTime, next, uvm_hdl_inj_time_cb_rtn);
+  uvm_hdl_inj_time_cb_at = next;
 }
 
+
+static PLI_INT32 uvm_hdl_inj_time_cb_rtn(p_cb_data cb)
+{
+  (void) cb;
+#ifndef VCS
+  vpi_release_handle(uvm_hdl_inj_time_cb);
+#endif
+  uvm_hdl_inj_time_cb = NULL;
+  uvm_hdl_inj_request_rw();
+  return 0;
+}
+
+
+static PLI_INT32 uvm_hdl_inj_rw_cb(p_cb_data cb)
+{
+  unsigned long long now;
+  UVM_DPI_PROF_BEGIN;
+
+  (void) cb;
+  uvm_hdl_inj_rw_pending = 0;
+  now = uvm_hdl_inj_now();
+  while (uvm_hdl_inj_heap_num > 0 && uvm_hdl_inj_heap[0].time <= now) {
+    uvm_hdl_inj_evt_t evt = uvm_hdl_inj_pop();
+    if (evt.apply)
+      uvm_hdl_inj_apply(evt.id, now);
+    else
+      uvm_hdl_inj_release(evt.id, now);
+  }
+  uvm_hdl_inj_schedule(now);
+  UVM_DPI_PROF_END(UVM_DPI_PROF_HDL_INJECT);
+  return 0;
+}
+
+
+/*
+ * Adds an injection of 'kind' on 'path' at absolute time 'start' and
+ * returns its id, or -1 if it cannot be scheduled. The caller requests
+ * the callback that applies it.
+ */
+static int uvm_hdl_inj_add(char *path, p_vpi_vecval value, p_vpi_vecval mask,
+                           unsigned long long start, unsigned long long duration,
+                           int kind)
+{
+  uvm_hdl_inj_t *inj;
+  int sig, words, i;
+  PLI_UINT32 last;
+
+  if (kind < UVM_HDL_INJECT_DEPOSIT || kind > UVM_HDL_INJECT_FLIP) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: inject: invalid injection kind %0d for '%s'\n", kind, path);
+    return -1;
+  }
+  sig = uvm_hdl_inj_sig(path);
+  if (sig < 0)
+    return -1;
+  words = uvm_hdl_inj_words(sig);
+
+  if (uvm_hdl_inj_buf == NULL) {
+    uvm_hdl_inj_buf = (p_vpi_vecval) calloc(uvm_hdl_inj_max_words, sizeof(s_vpi_vecval));
+    if (uvm_hdl_inj_buf == NULL) {
+      uvm_hdl_inj_alloc_error();
+      return -1;
+    }
+  }
+  if (uvm_hdl_inj_num == uvm_hdl_inj_max) {
+    int max = (uvm_hdl_inj_max == 0) ? 1024 : 2 * uvm_hdl_inj_max;
+    inj = (uvm_hdl_inj_t*) realloc(uvm_hdl_injs, max * sizeof(uvm_hdl_inj_t));
+    if (inj == NULL) {
+      uvm_hdl_inj_alloc_error();
+      return -1;
+    }
+    uvm_hdl_injs = inj;
+    uvm_hdl_inj_max = max;
+  }
+
+  inj = &uvm_hdl_injs[uvm_hdl_inj_num];
+  inj->value = (p_vpi_vecval) malloc(2 * words * sizeof(s_vpi_vecval));
+  if (inj->value == NULL) {
+    uvm_hdl_inj_alloc_error();
+    return -1;
+  }
+  inj->sig         = sig;
+  inj->kind        = kind;
+  inj->state       = UVM_HDL_INJECT_PENDING;
+  inj->masked      = 0;
+  inj->start       = start;
+  inj->duration    = (kind == UVM_HDL_INJECT_FORCE || kind == UVM_HDL_INJECT_FLIP) ? duration : 0;
+  inj->applied_at  = 0;
+  inj->released_at = 0;
+  memcpy(inj->value, value, words * sizeof(s_vpi_vecval));
+  memcpy(inj->value + words, mask, words * sizeof(s_vpi_vecval));
+
+  // A full mask needs no read of the current value
+  last = (uvm_hdl_inj_sigs[sig].size % 32) ? (1u << (uvm_hdl_inj_sigs[sig].size % 32)) - 1 : ~0u;
+  for (i = 0; i < words; i++)
+    if ((mask[i].aval & ((i == words - 1) ? last : ~0u)) != ((i == words - 1) ? last : ~0u))
+      inj->masked = 1;
+
+  if (!uvm_hdl_inj_push(inj->start, uvm_hdl_inj_num, 1)) {
+    uvm_hdl_inj_alloc_error();
+    free(inj->value);
+    return -1;
+  }
+  return uvm_hdl_inj_num++;
+}
+
+
+/*
+ * Makes sure the injections added in this time slot, the earliest of
+ * which is at 'start', are applied.
+ */
+static void uvm_hdl_inj_added(unsigned long long start)
+{
+  // The injections added in the same time slot are scheduled together
+  if (uvm_hdl_inj_time_cb == NULL || start < uvm_hdl_inj_time_cb_at)
+    uvm_hdl_inj_request_rw();
+}
+
+
+//--------------------------------------------------------------------
+// uvm_hdl_inject_add
+//
+// Schedules an injection of 'kind' on 'path', 'start' time units from
+// now, and returns its id, or -1 if it cannot be scheduled. Only the
+// bits set in 'mask' are written (or flipped). A force or flip with a
+// non-zero 'duration' is released 'duration' time units after being
+// applied.
+//--------------------------------------------------------------------
+
+int uvm_hdl_inject_add(char *path, p_vpi_vecval value, p_vpi_vecval mask,
+                       unsigned long long start, unsigned long long duration,
+                       int kind)
+{
+  int id;
+
+  start += uvm_hdl_inj_now();
+  id = uvm_hdl_inj_add(path, value, mask, start, duration, kind);
+  if (id >= 0)
+    uvm_hdl_inj_added(start);
+  return id;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_hdl_inject_add_batch
+//
+// Schedules one injection per element of 'paths', as uvm_hdl_inject_add
+// does with the elements of the same index of the other arrays, and
+// sets 'ids' to their ids (-1 for those that cannot be scheduled).
+// Returns the number of injections scheduled, or -1 if an array is
+// smaller than 'paths'.
+//--------------------------------------------------------------------
+
+int uvm_hdl_inject_add_batch(const svOpenArrayHandle paths,
+                             const svOpenArrayHandle values,
+                             const svOpenArrayHandle masks,
+                             const svOpenArrayHandle starts,
+                             const svOpenArrayHandle durations,
+                             const svOpenArrayHandle kinds,
+                             const svOpenArrayHandle ids)
+{
+  unsigned long long now, start, first = 0;
+  int n, i, id, added = 0;
+  UVM_DPI_PROF_BEGIN;
+
+  n = svSize(paths, 1);
+  if (svSize(values, 1) < n || svSize(masks, 1) < n || svSize(starts, 1) < n ||
+      svSize(durations, 1) < n || svSize(kinds, 1) < n || svSize(ids, 1) < n) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_hdl_inject_add_batch: %0d paths, but arrays of %0d values, %0d masks,\n",
+               n, svSize(values, 1), svSize(masks, 1));
+    vpi_printf((PLI_BYTE8*) " %0d start times, %0d durations, %0d kinds and %0d ids\n",
+               svSize(starts, 1), svSize(durations, 1), svSize(kinds, 1), svSize(ids, 1));
+    return -1;
+  }
+
+  now = uvm_hdl_inj_now();
+  for (i = 0; i < n; i++) {
+    char *path = *(char**) svGetArrElemPtr1(paths, svLow(paths, 1) + i);
+    start = now + *(unsigned long long*) svGetArrElemPtr1(starts, svLow(starts, 1) + i);
+    id = uvm_hdl_inj_add(path ? path : (char*) "",
+                         (p_vpi_vecval) svGetArrElemPtr1(values, svLow(values, 1) + i),
+                         (p_vpi_vecval) svGetArrElemPtr1(masks, svLow(masks, 1) + i),
+                         start,
+                         *(unsigned long long*) svGetArrElemPtr1(durations, svLow(durations, 1) + i),
+                         *(int*) svGetArrElemPtr1(kinds, svLow(kinds, 1) + i));
+    *(int*) svGetArrElemPtr1(ids, svLow(ids, 1) + i) = id;
+    if (id < 0)
+      continue;
+    if (added == 0 || start < first)
+      first = start;
+    added++;
+  }
+  if (added > 0)
+    uvm_hdl_inj_added(first);
+
+  UVM_DPI_PROF_END(UVM_DPI_PROF_HDL_INJECT_BATCH);
+  return added;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_hdl_inject_clear
+//
+// Cancels the pending injections and forgets all injections.
+// Signals that are forced remain forced.
+//--------------------------------------------------------------------
+
+void uvm_hdl_inject_clear()
+{
+  int i;
+
+  uvm_hdl_inj_cancel_time_cb();
+  for (i = 0; i < uvm_hdl_inj_num; i++)
+    free(uvm_hdl_injs[i].value);
+  uvm_hdl_inj_num = 0;
+  uvm_hdl_inj_applied = 0;
+  uvm_hdl_inj_heap_num = 0;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_hdl_inject_num
+//
+// Returns the number of injections added since the last clear.
+//--------------------------------------------------------------------
+
+int uvm_hdl_inject_num()
+{
+  return uvm_hdl_inj_num;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_hdl_inject_num_applied
+//
+// Returns the number of injections applied since the last clear.
+//--------------------------------------------------------------------
+
+int uvm_hdl_inject_num_applied()
+{
+  return uvm_hdl_inj_applied;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_hdl_inject_get
+//
+// Returns the state of injection 'id', or -1 if there is no such
+// injection, and its scheduled start time, the times it was applied
+// and released, and the value it applied (the released value for a
+// release).
+//--------------------------------------------------------------------
+
+int uvm_hdl_inject_get(int id, unsigned long long *start,
+                       unsigned long long *applied_at,
+                       unsigned long long *released_at,
+                       p_vpi_vecval value)
+{
+  uvm_hdl_inj_t *inj;
+  int words;
+
+  if (id < 0 || id >= uvm_hdl_inj_num)
+    return -1;
+  inj = &uvm_hdl_injs[id];
+  words = uvm_hdl_inj_words(inj->sig);
+  *start       = inj->start;
+  *applied_at  = inj->applied_at;
+  *released_at = inj->released_at;
+  memset(value, 0, uvm_hdl_inj_max_words * sizeof(s_vpi_vecval));
+  if (inj->state != UVM_HDL_INJECT_PENDING)
+    memcpy(value, inj->value, words * sizeof(s_vpi_vecval));
+  return inj->state;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_hdl_inject_get_path
+//
+// Returns the path of injection 'id', or "" if there is no such
+// injection.
+//--------------------------------------------------------------------
+
+const char *uvm_hdl_inject_get_path(int id)
+{
+  if (id < 0 || id >= uvm_hdl_inj_num)
+    return "";
+  return uvm_hdl_inj_sigs[uvm_hdl_injs[id].sig].path;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_hdl_inject_get_kind
+//
+// Returns the kind of injection 'id', or -1 if there is no such
+// injection.
+//--------------------------------------------------------------------
+
+int uvm_hdl_inject_get_kind(int id)
+{
+  if (id < 0 || id >= uvm_hdl_inj_num)
+    return -1;
+  return uvm_hdl_injs[id].kind;
+}
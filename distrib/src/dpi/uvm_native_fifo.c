@@ -0,0 +1,381 @@
+//----------------------------------------------------------------------
+//   Copyright 2007-2011 Mentor Graphics Corporation
+//   Copyright 2007-2011 Cadence Design Systems, Inc.
+//   Copyright 2010-2011 Synopsys, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+#include <malloc.h>
+#include <string.h>
+#include <stdlib.h>
+#include "svdpi.h"
+#include "vpi_user.h"
+#include "uvm_native_fifo.h"
+#include "uvm_dpi_array.h"
+
+
+/*
+ * Native bounded FIFOs backing uvm_tlm_native_fifo.
+ *
+ * Each FIFO is a ring buffer of fixed-size items, every item being
+ * 'words' 32-bit words. SystemVerilog moves whole batches of items
+ * in and out with one DPI call. C models find a FIFO by the full name
+ * of its uvm_tlm_native_fifo component and use the plain-pointer
+ * entry points declared in uvm_native_fifo.h, so producing or
+ * consuming a batch never crosses the language boundary.
+ *
+ * A size of 0 makes the FIFO unbounded; its storage then grows as
+ * needed. FIFOs are referred to by small integer handles; freed
+ * handles are reused.
+ */
+
+#define UVM_NATIVE_FIFO_MIN_CAP 16
+
+typedef struct uvm_native_fifo_s {
+  char *name;              // NULL if the handle is free
+  unsigned int *data;
+  int words;               // words per item
+  int size;                // bound, in items; 0 if unbounded
+  int cap;                 // allocated items
+  int head;                // index of the oldest item
+  int used;
+} uvm_native_fifo_t;
+
+static uvm_native_fifo_t *uvm_native_fifos = NULL;
+static int uvm_native_fifos_size = 0;
+
+
+static uvm_native_fifo_t *uvm_native_fifo_lookup(int h)
+{
+  if (h < 0 || h >= uvm_native_fifos_size || uvm_native_fifos[h].name == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_native_fifo: invalid fifo handle %0d\n", h);
+    return NULL;
+  }
+  return &uvm_native_fifos[h];
+}
+
+
+// Makes room for 'extra' more items, unwrapping the ring into the new
+// storage if it has to grow.
+
+static int uvm_native_fifo_reserve(uvm_native_fifo_t *f, int extra)
+{
+  unsigned int *data;
+  int cap, tail_items;
+
+  if (f->used + extra <= f->cap)
+    return 1;
+  cap = f->cap;
+  while (cap < f->used + extra)
+    cap *= 2;
+  data = (unsigned int*) malloc((size_t) cap * f->words * sizeof(unsigned int));
+  if (data == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_native_fifo: internal memory allocation error\n");
+    return 0;
+  }
+  tail_items = f->cap - f->head;
+  if (tail_items > f->used)
+    tail_items = f->used;
+  memcpy(data, f->data + (size_t) f->head * f->words,
+         (size_t) tail_items * f->words * sizeof(unsigned int));
+  memcpy(data + (size_t) tail_items * f->words, f->data,
+         (size_t) (f->used - tail_items) * f->words * sizeof(unsigned int));
+  free(f->data);
+  f->data = data;
+  f->cap = cap;
+  f->head = 0;
+  return 1;
+}
+
+
+// Copies 'n' items between the ring, starting at item 'pos', and 'buf'.
+
+static void uvm_native_fifo_copy(uvm_native_fifo_t *f, int pos,
+                                 unsigned int *buf, int n, int to_ring)
+{
+  int first = f->cap - pos;
+  size_t item = (size_t) f->words * sizeof(unsigned int);
+
+  if (first > n)
+    first = n;
+  if (to_ring) {
+    memcpy(f->data + (size_t) pos * f->words, buf, first * item);
+    memcpy(f->data, buf + (size_t) first * f->words, (n - first) * item);
+  }
+  else {
+    memcpy(buf, f->data + (size_t) pos * f->words, first * item);
+    memcpy(buf + (size_t) first * f->words, f->data, (n - first) * item);
+  }
+}
+
+
+//--------------------------------------------------------------------
+// uvm_native_fifo_new
+//
+// Creates a FIFO named 'name' holding at most 'size' items (0 for
+// unbounded) of 'words' 32-bit words each. Returns its handle, or -1
+// on failure.
+//--------------------------------------------------------------------
+
+int uvm_native_fifo_new(const char *name, int words, int size)
+{
+  uvm_native_fifo_t *f;
+  int h, cap;
+
+  if (words <= 0 || size < 0) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_native_fifo_new: invalid item width %0d or size %0d\n",
+               words, size);
+    return -1;
+  }
+
+  for (h = 0; h < uvm_native_fifos_size; h++)
+    if (uvm_native_fifos[h].name == NULL)
+      break;
+
+  if (h == uvm_native_fifos_size) {
+    int n = (uvm_native_fifos_size == 0) ? 8 : uvm_native_fifos_size * 2;
+    uvm_native_fifo_t *fifos = (uvm_native_fifo_t*) realloc(uvm_native_fifos,
+                                                            n * sizeof(uvm_native_fifo_t));
+    if (fifos == NULL) {
+      vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_native_fifo_new: internal memory allocation error\n");
+      return -1;
+    }
+    memset(fifos + uvm_native_fifos_size, 0,
+           (n - uvm_native_fifos_size) * sizeof(uvm_native_fifo_t));
+    uvm_native_fifos = fifos;
+    uvm_native_fifos_size = n;
+  }
+
+  // Storage grows on demand, so large bounds cost nothing until used
+  cap = (size > 0 && size < UVM_NATIVE_FIFO_MIN_CAP) ? size : UVM_NATIVE_FIFO_MIN_CAP;
+
+  f = &uvm_native_fifos[h];
+  f->data = (unsigned int*) malloc((size_t) cap * words * sizeof(unsigned int));
+  f->name = (char*) malloc(strlen(name == NULL ? "" : name) + 1);
+  if (f->data == NULL || f->name == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_native_fifo_new: internal memory allocation error\n");
+    free(f->data);
+    free(f->name);
+    memset(f, 0, sizeof(*f));
+    return -1;
+  }
+  strcpy(f->name, name == NULL ? "" : name);
+  f->words = words;
+  f->size = size;
+  f->cap = cap;
+  f->head = 0;
+  f->used = 0;
+  return h;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_native_fifo_free
+//
+// Releases FIFO 'h' and its contents.
+//--------------------------------------------------------------------
+
+void uvm_native_fifo_free(int h)
+{
+  uvm_native_fifo_t *f = uvm_native_fifo_lookup(h);
+  if (f == NULL)
+    return;
+  free(f->data);
+  free(f->name);
+  memset(f, 0, sizeof(*f));
+}
+
+
+//--------------------------------------------------------------------
+// uvm_native_fifo_find
+//
+// Returns the handle of the FIFO named 'name', or -1 if there is none.
+//--------------------------------------------------------------------
+
+int uvm_native_fifo_find(const char *name)
+{
+  int h;
+  if (name == NULL)
+    return -1;
+  for (h = 0; h < uvm_native_fifos_size; h++)
+    if (uvm_native_fifos[h].name != NULL && strcmp(uvm_native_fifos[h].name, name) == 0)
+      return h;
+  return -1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_native_fifo_used
+//
+// Returns the number of items in FIFO 'h'.
+//--------------------------------------------------------------------
+
+int uvm_native_fifo_used(int h)
+{
+  uvm_native_fifo_t *f = uvm_native_fifo_lookup(h);
+  return (f == NULL) ? 0 : f->used;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_native_fifo_item_words
+//
+// Returns the number of 32-bit words per item of FIFO 'h'.
+//--------------------------------------------------------------------
+
+int uvm_native_fifo_item_words(int h)
+{
+  uvm_native_fifo_t *f = uvm_native_fifo_lookup(h);
+  return (f == NULL) ? 0 : f->words;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_native_fifo_write
+//
+// Appends up to 'n' items from 'buf' to FIFO 'h', as many as fit.
+// Returns the number of items appended.
+//--------------------------------------------------------------------
+
+int uvm_native_fifo_write(int h, const unsigned int *buf, int n)
+{
+  uvm_native_fifo_t *f = uvm_native_fifo_lookup(h);
+
+  if (f == NULL || n <= 0)
+    return 0;
+  if (f->size != 0 && n > f->size - f->used)
+    n = f->size - f->used;
+  if (n <= 0)
+    return 0;
+  if (!uvm_native_fifo_reserve(f, n))
+    return 0;
+
+  uvm_native_fifo_copy(f, (f->head + f->used) % f->cap, (unsigned int*) buf, n, 1);
+  f->used += n;
+  return n;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_native_fifo_read
+//
+// Removes up to 'n' of the oldest items from FIFO 'h' into 'buf'.
+// If 'peek' is set, the items are copied but left in the FIFO.
+// Returns the number of items read.
+//--------------------------------------------------------------------
+
+int uvm_native_fifo_read(int h, unsigned int *buf, int n, int peek)
+{
+  uvm_native_fifo_t *f = uvm_native_fifo_lookup(h);
+
+  if (f == NULL || n <= 0)
+    return 0;
+  if (n > f->used)
+    n = f->used;
+  if (n == 0)
+    return 0;
+
+  uvm_native_fifo_copy(f, f->head, buf, n, 0);
+  if (!peek) {
+    f->head = (f->head + n) % f->cap;
+    f->used -= n;
+    if (f->used == 0)
+      f->head = 0;
+  }
+  return n;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_native_fifo_put_n
+//
+// DPI entry point for <uvm_native_fifo_write>: appends up to 'n' items
+// held in the open array 'items', as many as fit.
+//--------------------------------------------------------------------
+
+int uvm_native_fifo_put_n(int h, const svOpenArrayHandle items, int n)
+{
+  uvm_native_fifo_t *f = uvm_native_fifo_lookup(h);
+  const unsigned int *p;
+  unsigned int *tmp;
+  int words, r;
+
+  if (f == NULL || n <= 0)
+    return 0;
+  words = n * f->words;
+  if (svSize(items, 1) < words) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_native_fifo_put_n: %0d items requested, array holds %0d words\n",
+               n, svSize(items, 1));
+    return 0;
+  }
+
+  p = (const unsigned int*) svGetArrayPtr(items);
+  if (p != NULL)
+    return uvm_native_fifo_write(h, p, n);
+
+  // The simulator does not store the array contiguously
+  tmp = (unsigned int*) malloc((size_t) words * sizeof(unsigned int));
+  if (tmp == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_native_fifo_put_n: internal memory allocation error\n");
+    return 0;
+  }
+  uvm_dpi_array_get(items, tmp, words);
+  r = uvm_native_fifo_write(h, tmp, n);
+  free(tmp);
+  return r;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_native_fifo_get_n
+//
+// DPI entry point for <uvm_native_fifo_read>: moves up to 'n' of the
+// oldest items into the open array 'items', or copies them if 'peek'
+// is set.
+//--------------------------------------------------------------------
+
+int uvm_native_fifo_get_n(int h, const svOpenArrayHandle items, int n, int peek)
+{
+  uvm_native_fifo_t *f = uvm_native_fifo_lookup(h);
+  unsigned int *p, *tmp;
+  int r;
+
+  if (f == NULL || n <= 0)
+    return 0;
+  if (svSize(items, 1) < n * f->words) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_native_fifo_get_n: %0d items requested, array holds %0d words\n",
+               n, svSize(items, 1));
+    return 0;
+  }
+
+  p = (unsigned int*) svGetArrayPtr(items);
+  if (p != NULL)
+    return uvm_native_fifo_read(h, p, n, peek);
+
+  // The simulator does not store the array contiguously
+  tmp = (unsigned int*) malloc((size_t) n * f->words * sizeof(unsigned int));
+  if (tmp == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_native_fifo_get_n: internal memory allocation error\n");
+    return 0;
+  }
+  r = uvm_native_fifo_read(h, tmp, n, peek);
+  uvm_dpi_array_put(items, tmp, r * f->words);
+  free(tmp);
+  return r;
+}
+
@@ -0,0 +1,51 @@
+/*----------------------------------------------------------------------
+ *   Copyright 2007-2011 Mentor Graphics Corporation
+ *   Copyright 2007-2011 Cadence Design Systems, Inc.
+ *   Copyright 2010-2011 Synopsys, Inc.
+ *   All Rights Reserved Worldwide
+ *
+ *   Licensed under the Apache License, Version 2.0 (the
+ *   "License"); you may not use this file except in
+ *   compliance with the License.  You may obtain a copy of
+ *   the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in
+ *   writing, software distributed under the License is
+ *   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ *   CONDITIONS OF ANY KIND, either express or implied.  See
+ *   the License for the specific language governing
+ *   permissions and limitations under the License.
+ *----------------------------------------------------------------------*/
+
+/*
+ * C interface to uvm_tlm_native_fifo, for reference models linked with
+ * the UVM DPI library. A model looks a FIFO up once by the full name of
+ * its uvm_tlm_native_fifo component, then moves whole batches of items
+ * with plain pointers. Each item is uvm_native_fifo_item_words() 32-bit
+ * words, least significant word first.
+ *
+ * After producing into or consuming from a FIFO, and before returning
+ * to SystemVerilog, the model's caller should call the component's
+ * notify() method so that blocked SystemVerilog puts and gets retry.
+ */
+
+#ifndef UVM_NATIVE_FIFO_H
+#define UVM_NATIVE_FIFO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int uvm_native_fifo_find(const char *name);
+int uvm_native_fifo_used(int h);
+int uvm_native_fifo_item_words(int h);
+int uvm_native_fifo_write(int h, const unsigned int *buf, int n);
+int uvm_native_fifo_read(int h, unsigned int *buf, int n, int peek);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UVM_NATIVE_FIFO_H */
@@ -0,0 +1,532 @@
+//----------------------------------------------------------------------
+//   Copyright 2007-2011 Mentor Graphics Corporation
+//   Copyright 2007-2011 Cadence Design Systems, Inc.
+//   Copyright 2010-2011 Synopsys, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+#include <malloc.h>
+#include <string.h>
+#include <stdlib.h>
+#include "svdpi.h"
+#include "vpi_user.h"
+#include "uvm_dpi_profile.h"
+#include "uvm_refmodel.h"
+#include "uvm_dpi_array.h"
+
+#if defined(_WIN32) && !defined(UVM_REFMODEL_NO_THREADS)
+#define UVM_REFMODEL_NO_THREADS
+#endif
+
+#ifndef UVM_REFMODEL_NO_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+
+/*
+ * Reference-model worker pools.
+ *
+ * A pool runs the items submitted by SystemVerilog through a native
+ * reference model (see uvm_refmodel.h) on its own worker threads, so
+ * that the transformations overlap with the simulation and with one
+ * another. Results are collected strictly in submission order,
+ * whichever thread completes them first, which keeps the comparisons
+ * deterministic.
+ *
+ * Jobs are kept in a ring of job pointers indexed by sequence number:
+ * 'head' is the oldest job not yet collected, 'next' the next job to
+ * be started by a worker and 'tail' the next job to be submitted.
+ * Workers only look at the ring with the pool mutex held, and the job
+ * they run stays allocated until it is collected.
+ *
+ * Compiled with UVM_REFMODEL_NO_THREADS, as on Windows, or if no
+ * worker thread can be started, a pool runs each model when its item
+ * is submitted.
+ *
+ * Pools are referred to by small integer handles; freed handles are
+ * reused.
+ */
+
+#define UVM_REFMODEL_MIN_CAP 64
+
+typedef struct uvm_refmodel_s {
+  char *name;
+  uvm_refmodel_fn fn;
+  void *ctx;
+} uvm_refmodel_t;
+
+typedef struct uvm_refmodel_job_s {
+  unsigned int *in;
+  int n_in;
+  unsigned int *out;
+  int n_out;               // -1 if the model failed
+  int done;
+} uvm_refmodel_job_t;
+
+typedef struct uvm_refmodel_pool_s {
+  uvm_refmodel_fn fn;
+  void *ctx;
+  int max_out;             // words per result
+  uvm_refmodel_job_t **jobs;
+  unsigned int cap;        // a power of 2
+  unsigned long long head;
+  unsigned long long next;
+  unsigned long long tail;
+  int stop;
+  int n_threads;           // 0 if the models run on submission
+#ifndef UVM_REFMODEL_NO_THREADS
+  pthread_t *threads;
+  pthread_mutex_t mutex;
+  pthread_cond_t work;     // a job was submitted, or the pool stops
+  pthread_cond_t done;     // a job completed
+#endif
+} uvm_refmodel_pool_t;
+
+static uvm_refmodel_t *uvm_refmodels = NULL;
+static int uvm_refmodels_num = 0;
+
+static uvm_refmodel_pool_t **uvm_refmodel_pools = NULL;
+static int uvm_refmodel_pools_size = 0;
+
+
+static uvm_refmodel_pool_t *uvm_refmodel_lookup(int h)
+{
+  if (h < 0 || h >= uvm_refmodel_pools_size || uvm_refmodel_pools[h] == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_refmodel: invalid pool handle %0d\n", h);
+    return NULL;
+  }
+  return uvm_refmodel_pools[h];
+}
+
+
+#ifndef UVM_REFMODEL_NO_THREADS
+#define UVM_REFMODEL_LOCK(p)   if ((p)->n_threads) pthread_mutex_lock(&(p)->mutex)
+#define UVM_REFMODEL_UNLOCK(p) if ((p)->n_threads) pthread_mutex_unlock(&(p)->mutex)
+#else
+#define UVM_REFMODEL_LOCK(p)
+#define UVM_REFMODEL_UNLOCK(p)
+#endif
+
+
+// Runs job 'j' through the model of pool 'p'
+
+static void uvm_refmodel_run(uvm_refmodel_pool_t *p, uvm_refmodel_job_t *j)
+{
+  j->out = (unsigned int*) malloc((size_t) p->max_out * sizeof(unsigned int));
+  if (j->out == NULL)
+    j->n_out = -1;
+  else {
+    j->n_out = p->fn(p->ctx, j->in, j->n_in, j->out, p->max_out);
+    if (j->n_out > p->max_out)
+      j->n_out = -1;
+  }
+  free(j->in);
+  j->in = NULL;
+}
+
+
+static void uvm_refmodel_job_free(uvm_refmodel_job_t *j)
+{
+  free(j->in);
+  free(j->out);
+  free(j);
+}
+
+
+#ifndef UVM_REFMODEL_NO_THREADS
+
+static void *uvm_refmodel_worker(void *arg)
+{
+  uvm_refmodel_pool_t *p = (uvm_refmodel_pool_t*) arg;
+
+  pthread_mutex_lock(&p->mutex);
+  for (;;) {
+    uvm_refmodel_job_t *j;
+
+    while (!p->stop && p->next == p->tail)
+      pthread_cond_wait(&p->work, &p->mutex);
+    if (p->stop)
+      break;
+
+    j = p->jobs[p->next & (p->cap - 1)];
+    p->next++;
+    pthread_mutex_unlock(&p->mutex);
+
+    uvm_refmodel_run(p, j);
+
+    pthread_mutex_lock(&p->mutex);
+    j->done = 1;
+    pthread_cond_broadcast(&p->done);
+  }
+  pthread_mutex_unlock(&p->mutex);
+  return NULL;
+}
+
+#endif
+
+
+// Doubles the ring of pool 'p', keeping each job at its sequence number
+
+static int uvm_refmodel_grow(uvm_refmodel_pool_t *p)
+{
+  unsigned int cap = p->cap * 2;
+  uvm_refmodel_job_t **jobs;
+  unsigned long long s;
+
+  jobs = (uvm_refmodel_job_t**) malloc(cap * sizeof(uvm_refmodel_job_t*));
+  if (jobs == NULL)
+    return 0;
+  for (s = p->head; s != p->tail; s++)
+    jobs[s & (cap - 1)] = p->jobs[s & (p->cap - 1)];
+  free(p->jobs);
+  p->jobs = jobs;
+  p->cap = cap;
+  return 1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_refmodel_register
+//
+// Registers the reference model 'fn' under 'name', replacing any model
+// of the same name. Returns 1 on success.
+//--------------------------------------------------------------------
+
+int uvm_refmodel_register(const char *name, uvm_refmodel_fn fn, void *ctx)
+{
+  uvm_refmodel_t *models;
+  int i;
+
+  if (name == NULL || fn == NULL)
+    return 0;
+
+  for (i = 0; i < uvm_refmodels_num; i++)
+    if (strcmp(uvm_refmodels[i].name, name) == 0) {
+      uvm_refmodels[i].fn = fn;
+      uvm_refmodels[i].ctx = ctx;
+      return 1;
+    }
+
+  models = (uvm_refmodel_t*) realloc(uvm_refmodels,
+                                     (uvm_refmodels_num + 1) * sizeof(uvm_refmodel_t));
+  if (models == NULL)
+    return 0;
+  uvm_refmodels = models;
+  models[i].name = (char*) malloc(strlen(name) + 1);
+  if (models[i].name == NULL)
+    return 0;
+  strcpy(models[i].name, name);
+  models[i].fn = fn;
+  models[i].ctx = ctx;
+  uvm_refmodels_num++;
+  return 1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_refmodel_pool_new
+//
+// Creates a pool of 'n_threads' worker threads, or one per online
+// processor if 'n_threads' is 0, running the reference model named
+// 'model', whose results are at most 'max_out' words. Returns its
+// handle, or -1 on failure.
+//--------------------------------------------------------------------
+
+int uvm_refmodel_pool_new(const char *model, int n_threads, int max_out)
+{
+  uvm_refmodel_pool_t *p;
+  int h, m;
+
+  for (m = 0; m < uvm_refmodels_num; m++)
+    if (model != NULL && strcmp(uvm_refmodels[m].name, model) == 0)
+      break;
+  if (m == uvm_refmodels_num) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_refmodel_pool_new: no reference model named '%s' is registered\n",
+               model == NULL ? "" : model);
+    return -1;
+  }
+  if (max_out <= 0 || n_threads < 0) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_refmodel_pool_new: invalid result size %0d or thread count %0d\n",
+               max_out, n_threads);
+    return -1;
+  }
+
+  for (h = 0; h < uvm_refmodel_pools_size; h++)
+    if (uvm_refmodel_pools[h] == NULL)
+      break;
+
+  if (h == uvm_refmodel_pools_size) {
+    int n = (uvm_refmodel_pools_size == 0) ? 8 : uvm_refmodel_pools_size * 2;
+    uvm_refmodel_pool_t **pools = (uvm_refmodel_pool_t**)
+      realloc(uvm_refmodel_pools, n * sizeof(uvm_refmodel_pool_t*));
+    if (pools == NULL) {
+      vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_refmodel_pool_new: internal memory allocation error\n");
+      return -1;
+    }
+    memset(pools + uvm_refmodel_pools_size, 0,
+           (n - uvm_refmodel_pools_size) * sizeof(uvm_refmodel_pool_t*));
+    uvm_refmodel_pools = pools;
+    uvm_refmodel_pools_size = n;
+  }
+
+  p = (uvm_refmodel_pool_t*) calloc(1, sizeof(uvm_refmodel_pool_t));
+  if (p != NULL)
+    p->jobs = (uvm_refmodel_job_t**) malloc(UVM_REFMODEL_MIN_CAP * sizeof(uvm_refmodel_job_t*));
+  if (p == NULL || p->jobs == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_refmodel_pool_new: internal memory allocation error\n");
+    free(p);
+    return -1;
+  }
+  p->fn = uvm_refmodels[m].fn;
+  p->ctx = uvm_refmodels[m].ctx;
+  p->max_out = max_out;
+  p->cap = UVM_REFMODEL_MIN_CAP;
+
+#ifndef UVM_REFMODEL_NO_THREADS
+  if (n_threads == 0) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    n_threads = (n > 0) ? (int) n : 1;
+  }
+  p->threads = (pthread_t*) malloc(n_threads * sizeof(pthread_t));
+  if (p->threads != NULL) {
+    pthread_mutex_init(&p->mutex, NULL);
+    pthread_cond_init(&p->work, NULL);
+    pthread_cond_init(&p->done, NULL);
+    p->n_threads = n_threads;
+    for (m = 0; m < n_threads; m++)
+      if (pthread_create(&p->threads[m], NULL, uvm_refmodel_worker, p) != 0)
+        break;
+    if (m < n_threads) {
+      pthread_mutex_lock(&p->mutex);
+      p->n_threads = m;
+      pthread_mutex_unlock(&p->mutex);
+    }
+    if (p->n_threads == 0) {
+      vpi_printf((PLI_BYTE8*) "UVM_WARNING: uvm_refmodel_pool_new: unable to start worker threads, running the '%s' model on submission\n",
+                 model);
+      pthread_cond_destroy(&p->done);
+      pthread_cond_destroy(&p->work);
+      pthread_mutex_destroy(&p->mutex);
+      free(p->threads);
+      p->threads = NULL;
+    }
+  }
+#endif
+
+  uvm_refmodel_pools[h] = p;
+  return h;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_refmodel_pool_free
+//
+// Stops the worker threads of pool 'h', once they have completed the
+// jobs they are running, and discards its pending jobs.
+//--------------------------------------------------------------------
+
+void uvm_refmodel_pool_free(int h)
+{
+  uvm_refmodel_pool_t *p = uvm_refmodel_lookup(h);
+  unsigned long long s;
+
+  if (p == NULL)
+    return;
+
+#ifndef UVM_REFMODEL_NO_THREADS
+  if (p->n_threads) {
+    int i;
+    pthread_mutex_lock(&p->mutex);
+    p->stop = 1;
+    pthread_cond_broadcast(&p->work);
+    pthread_mutex_unlock(&p->mutex);
+    for (i = 0; i < p->n_threads; i++)
+      pthread_join(p->threads[i], NULL);
+    pthread_cond_destroy(&p->done);
+    pthread_cond_destroy(&p->work);
+    pthread_mutex_destroy(&p->mutex);
+    free(p->threads);
+  }
+#endif
+
+  for (s = p->head; s != p->tail; s++)
+    uvm_refmodel_job_free(p->jobs[s & (p->cap - 1)]);
+  free(p->jobs);
+  free(p);
+  uvm_refmodel_pools[h] = NULL;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_refmodel_num_threads
+//
+// Returns the number of worker threads of pool 'h', 0 if its model
+// runs on submission.
+//--------------------------------------------------------------------
+
+int uvm_refmodel_num_threads(int h)
+{
+  uvm_refmodel_pool_t *p = uvm_refmodel_lookup(h);
+  return (p == NULL) ? 0 : p->n_threads;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_refmodel_pending
+//
+// Returns the number of items submitted to pool 'h' and not yet
+// collected.
+//--------------------------------------------------------------------
+
+int uvm_refmodel_pending(int h)
+{
+  uvm_refmodel_pool_t *p = uvm_refmodel_lookup(h);
+  int n;
+
+  if (p == NULL)
+    return 0;
+  UVM_REFMODEL_LOCK(p);
+  n = (int) (p->tail - p->head);
+  UVM_REFMODEL_UNLOCK(p);
+  return n;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_refmodel_submit
+//
+// Submits the item held in the first 'n_words' words of the open array
+// 'words' to pool 'h'. Returns 1 on success.
+//--------------------------------------------------------------------
+
+int uvm_refmodel_submit(int h, const svOpenArrayHandle words, int n_words)
+{
+  uvm_refmodel_pool_t *p = uvm_refmodel_lookup(h);
+  uvm_refmodel_job_t *j;
+  int ok = 1;
+
+  if (p == NULL)
+    return 0;
+  if (n_words < 0 || svSize(words, 1) < n_words) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_refmodel_submit: %0d words submitted, array holds %0d words\n",
+               n_words, svSize(words, 1));
+    return 0;
+  }
+
+  j = (uvm_refmodel_job_t*) calloc(1, sizeof(uvm_refmodel_job_t));
+  if (j != NULL)
+    j->in = (unsigned int*) malloc((n_words > 0 ? n_words : 1) * sizeof(unsigned int));
+  if (j == NULL || j->in == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_refmodel_submit: internal memory allocation error\n");
+    free(j);
+    return 0;
+  }
+  j->n_in = n_words;
+
+  uvm_dpi_array_get(words, j->in, n_words);
+
+  if (p->n_threads == 0) {
+    uvm_refmodel_run(p, j);
+    j->done = 1;
+  }
+
+  UVM_REFMODEL_LOCK(p);
+  if (p->tail - p->head == p->cap)
+    ok = uvm_refmodel_grow(p);
+  if (ok) {
+    p->jobs[p->tail & (p->cap - 1)] = j;
+    p->tail++;
+#ifndef UVM_REFMODEL_NO_THREADS
+    if (p->n_threads)
+      pthread_cond_signal(&p->work);
+#endif
+  }
+  UVM_REFMODEL_UNLOCK(p);
+
+  if (!ok) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_refmodel_submit: internal memory allocation error\n");
+    uvm_refmodel_job_free(j);
+  }
+  return ok;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_refmodel_collect
+//
+// Collects the results of up to 'n' of the oldest items submitted to
+// pool 'h', in submission order, waiting for them to complete. The
+// words of the results are stored one after the other in the open
+// array 'words' and the number of words of each result in the open
+// array 'lens', -1 if the model failed. Stops early when either array
+// is full. Returns the number of results collected.
+//--------------------------------------------------------------------
+
+int uvm_refmodel_collect(int h, const svOpenArrayHandle words,
+                         const svOpenArrayHandle lens, int n)
+{
+  uvm_refmodel_pool_t *p = uvm_refmodel_lookup(h);
+  unsigned int *dst;
+  int *dst_lens;
+  int max_words, max_lens, lo, lens_lo, used = 0, k, i;
+  UVM_DPI_PROF_BEGIN;
+
+  if (p == NULL || n <= 0)
+    return 0;
+
+  max_words = svSize(words, 1);
+  max_lens = svSize(lens, 1);
+  dst = (unsigned int*) svGetArrayPtr(words);
+  dst_lens = (int*) svGetArrayPtr(lens);
+  lo = svLow(words, 1);
+  lens_lo = svLow(lens, 1);
+
+  UVM_REFMODEL_LOCK(p);
+  for (k = 0; k < n && k < max_lens && p->head != p->tail; k++) {
+    uvm_refmodel_job_t *j = p->jobs[p->head & (p->cap - 1)];
+    int nw;
+
+#ifndef UVM_REFMODEL_NO_THREADS
+    while (!j->done)
+      pthread_cond_wait(&p->done, &p->mutex);
+#endif
+
+    nw = (j->n_out < 0) ? 0 : j->n_out;
+    if (used + nw > max_words)
+      break;
+
+    if (dst != NULL)
+      memcpy(dst + used, j->out, nw * sizeof(unsigned int));
+    else
+      for (i = 0; i < nw; i++)
+        *(unsigned int*) svGetArrElemPtr1(words, lo + used + i) = j->out[i];
+    if (dst_lens != NULL)
+      dst_lens[k] = j->n_out;
+    else
+      *(int*) svGetArrElemPtr1(lens, lens_lo + k) = j->n_out;
+    used += nw;
+
+    p->head++;
+    uvm_refmodel_job_free(j);
+  }
+  UVM_REFMODEL_UNLOCK(p);
+
+  UVM_DPI_PROF_END(UVM_DPI_PROF_REFMODEL_COLLECT);
+  return k;
+}
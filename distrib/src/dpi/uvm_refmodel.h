@@ -0,0 +1,59 @@
+/*----------------------------------------------------------------------
+ *   Copyright 2007-2011 Mentor Graphics Corporation
+ *   Copyright 2007-2011 Cadence Design Systems, Inc.
+ *   Copyright 2010-2011 Synopsys, Inc.
+ *   All Rights Reserved Worldwide
+ *
+ *   Licensed under the Apache License, Version 2.0 (the
+ *   "License"); you may not use this file except in
+ *   compliance with the License.  You may obtain a copy of
+ *   the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in
+ *   writing, software distributed under the License is
+ *   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ *   CONDITIONS OF ANY KIND, either express or implied.  See
+ *   the License for the specific language governing
+ *   permissions and limitations under the License.
+ *----------------------------------------------------------------------*/
+
+
+/*
+ * C interface to the reference-model worker pools behind
+ * uvm_native_algorithmic_comparator.
+ *
+ * A reference model is a function transforming one BEFORE item into
+ * one AFTER item, both being streams of 32-bit words as produced and
+ * consumed by uvm_object::pack_ints and unpack_ints. It returns the
+ * number of words written to 'out', at most 'max_out', or -1 if the
+ * item could not be transformed.
+ *
+ * Models run concurrently on the worker threads of a pool, so they
+ * must be reentrant, and may not call back into SystemVerilog or the
+ * VPI. 'ctx' is the pointer given when the model was registered.
+ *
+ * Models are registered by name, before the comparator using them is
+ * created, e.g. from a DPI function called at time 0 or from a
+ * constructor function of the shared library.
+ */
+
+#ifndef UVM_REFMODEL_H
+#define UVM_REFMODEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int (*uvm_refmodel_fn)(void *ctx,
+                               const unsigned int *in, int n_in,
+                               unsigned int *out, int max_out);
+
+int uvm_refmodel_register(const char *name, uvm_refmodel_fn fn, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UVM_REFMODEL_H */
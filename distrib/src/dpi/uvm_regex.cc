@@ -24,6 +24,7 @@
 #include <sys/types.h>
 #include <regex.h>
 #include "vpi_user.h"
+#include "uvm_dpi_profile.h"
 //#include <stdio.h>
 
 
@@ -31,6 +32,41 @@ const char uvm_re_bracket_char = '/';
 static char uvm_re[2048];
 
 
+/*
+ * Compiled regular expression cache.
+ *
+ * Set-associative on a hash of the expression text as passed to
+ * uvm_re_match (brackets included): an expression can be cached in
+ * any of the UVM_RE_CACHE_WAYS entries of its set, so a few hot
+ * expressions with the same hash do not evict each other. A new
+ * expression replaces the least recently used entry of its set.
+ */
+
+#define UVM_RE_CACHE_SIZE 256   // power of 2
+#define UVM_RE_CACHE_WAYS 4     // entries per set, power of 2
+
+typedef struct uvm_re_cache_s {
+  char *re;
+  regex_t rexp;
+  unsigned int hits;
+  unsigned long long last_use;
+} uvm_re_cache_t;
+
+static uvm_re_cache_t uvm_re_cache[UVM_RE_CACHE_SIZE];
+static unsigned long long uvm_re_cache_uses = 0;
+
+
+static unsigned int uvm_re_hash(const char *s)
+{
+  unsigned int h = 2166136261u;
+  while (*s) {
+    h ^= (unsigned char)*s++;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+
 //--------------------------------------------------------------------
 // uvm_re_match
 //
@@ -40,11 +76,13 @@ static char uvm_re[2048];
 // is compiled and cached for future use.  After compilation the
 // matching is done using regexec().
 //--------------------------------------------------------------------
-int uvm_re_match(const char * re, const char *str)
+static int uvm_re_match_impl(const char * re, const char *str)
 {
-  regex_t *rexp;
+  uvm_re_cache_t *set, *entry;
   int err;
-  int len = strlen(re);
+  int len;
+  int i;
+  char * key;
   char * rex = &uvm_re[0];
 
   // safety check.  Args should never be null since this is called
@@ -54,6 +92,21 @@ int uvm_re_match(const char * re, const char *str)
   if(str == NULL)
     return 1;
 
+  set = &uvm_re_cache[uvm_re_hash(re) & (UVM_RE_CACHE_SIZE-1) & ~(UVM_RE_CACHE_WAYS-1)];
+  entry = set;
+  for (i = 0; i < UVM_RE_CACHE_WAYS; i++) {
+    if (set[i].re != NULL && strcmp(set[i].re, re) == 0) {
+      set[i].hits++;
+      set[i].last_use = ++uvm_re_cache_uses;
+      return regexec(&set[i].rexp, str, 0, NULL, 0);
+    }
+    // Replace a free entry, or else the least recently used one
+    if (entry->re != NULL && (set[i].re == NULL || set[i].last_use < entry->last_use))
+      entry = &set[i];
+  }
+
+  len = strlen(re);
+
   /*
   if (len == 0) {
     vpi_printf((PLI_BYTE8*)  "UVM_ERROR: uvm_re_match : regular expression empty\n");
@@ -65,34 +118,57 @@ int uvm_re_match(const char * re, const char *str)
     return 1;
   }
 
+  // The cache key is copied first: 're' may be the result of
+  // uvm_glob_to_re, i.e. uvm_re itself, which is modified below
+  key = (char*)malloc(len+1);
+  if (key == NULL) {
+    vpi_printf((PLI_BYTE8*)  "UVM_ERROR: uvm_re_match: internal memory allocation error");
+    return 1;
+  }
+  memcpy(key, re, len+1);
+
   // we copy the regexp because we need to remove any brackets around it
-  strcpy(&uvm_re[0],re);
-  if (len>1 && (re[0] == uvm_re_bracket_char) && re[len-1] == uvm_re_bracket_char) {
+  memcpy(&uvm_re[0],key,len+1);
+  if (len>1 && (key[0] == uvm_re_bracket_char) && key[len-1] == uvm_re_bracket_char) {
     uvm_re[len-1] = '\0';
     rex++;
   }
 
-  rexp = (regex_t*)malloc(sizeof(regex_t));
-
-  if (rexp == NULL) {
-    vpi_printf((PLI_BYTE8*)  "UVM_ERROR: uvm_re_match: internal memory allocation error");
-    return 1;
+  if (entry->re != NULL) {
+    regfree(&entry->rexp);
+    free(entry->re);
+    entry->re = NULL;
   }
 
-  err = regcomp(rexp, rex, REG_EXTENDED);
+  {
+    UVM_DPI_PROF_BEGIN;
+    err = regcomp(&entry->rexp, rex, REG_EXTENDED);
+    UVM_DPI_PROF_END(UVM_DPI_PROF_RE_COMPILE);
+  }
 
   if (err != 0) {
-    vpi_printf((PLI_BYTE8*)  "UVM_ERROR: uvm_re_match: invalid glob or regular expression: |%s|\n",re);
-    regfree(rexp);
+    vpi_printf((PLI_BYTE8*)  "UVM_ERROR: uvm_re_match: invalid glob or regular expression: |%s|\n",key);
+    free(key);
     return err;
   }
 
-  err = regexec(rexp, str, 0, NULL, 0);
+  entry->re = key;
+  entry->hits = 0;
+  entry->last_use = ++uvm_re_cache_uses;
+
+  err = regexec(&entry->rexp, str, 0, NULL, 0);
 
   //vpi_printf((PLI_BYTE8*)  "UVM_INFO: uvm_re_match: re=%s str=%s ERR=%0d\n",rex,str,err);
 
-  regfree(rexp);
+  return err;
+}
 
+int uvm_re_match(const char * re, const char *str)
+{
+  int err;
+  UVM_DPI_PROF_BEGIN;
+  err = uvm_re_match_impl(re, str);
+  UVM_DPI_PROF_END(UVM_DPI_PROF_RE_MATCH);
   return err;
 }
 
@@ -103,7 +179,7 @@ int uvm_re_match(const char * re, const char *str)
 // Convert a glob expression to a normal regular expression.
 //--------------------------------------------------------------------
 
-const char * uvm_glob_to_re(const char *glob)
+static const char * uvm_glob_to_re_impl(const char *glob)
 {
   const char *p;
   int len;
@@ -214,6 +290,15 @@ const char * uvm_glob_to_re(const char *glob)
   return &uvm_re[0];
 }
 
+const char * uvm_glob_to_re(const char *glob)
+{
+  const char *re;
+  UVM_DPI_PROF_BEGIN;
+  re = uvm_glob_to_re_impl(glob);
+  UVM_DPI_PROF_END(UVM_DPI_PROF_GLOB_TO_RE);
+  return re;
+}
+
 
 //--------------------------------------------------------------------
 // uvm_dump_re_cache
@@ -223,6 +308,16 @@ const char * uvm_glob_to_re(const char *glob)
 
 void uvm_dump_re_cache()
 {
-  vpi_printf((PLI_BYTE8*)  "uvm_dump_re_cache: cache not implemented");
+  int i, used = 0;
+
+  for (i = 0; i < UVM_RE_CACHE_SIZE; i++) {
+    if (uvm_re_cache[i].re == NULL)
+      continue;
+    used++;
+    vpi_printf((PLI_BYTE8*)  "  %3d: %8u hits  %s\n", i, uvm_re_cache[i].hits,
+               uvm_re_cache[i].re);
+  }
+  vpi_printf((PLI_BYTE8*)  "uvm_dump_re_cache: %0d of %0d entries in use\n",
+             used, UVM_RE_CACHE_SIZE);
 }
 
@@ -0,0 +1,332 @@
+//----------------------------------------------------------------------
+//   Copyright 2007-2011 Mentor Graphics Corporation
+//   Copyright 2007-2011 Cadence Design Systems, Inc.
+//   Copyright 2010-2011 Synopsys, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+#include <malloc.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "vpi_user.h"
+
+
+/*
+ * UVM binary report stream.
+ *
+ * Every report processed by uvm_report_server can be appended to a
+ * compact, length-prefixed binary stream in addition to (or instead of)
+ * the text log. Component names, report IDs and file names are interned:
+ * each distinct string is written once as a STR record and referenced
+ * by its 32-bit id afterwards.
+ *
+ * Stream layout (all integers little-endian):
+ *
+ *   header : "UVMRPTS\0" u32 version u32 reserved
+ *   record : u8 kind u32 payload_len payload[payload_len]
+ *
+ *   kind 1 (STR) : u32 sid, bytes[payload_len-4]
+ *   kind 2 (MSG) : u64 time, u32 name_sid, u32 id_sid, u32 file_sid,
+ *                  u32 line, i32 verbosity, u32 action, u8 severity,
+ *                  bytes message[payload_len-33]
+ *
+ * The uvm_report_index utility (distrib/bin) reads this format.
+ */
+
+#define UVM_RPT_STREAM_VERSION   1
+#define UVM_RPT_STREAM_KIND_STR  1
+#define UVM_RPT_STREAM_KIND_MSG  2
+#define UVM_RPT_STREAM_MSG_FIXED 33
+#define UVM_RPT_STREAM_BUF_SIZE  (256*1024)
+
+typedef struct uvm_rpt_str_s {
+  char *str;
+  unsigned int hash;
+  unsigned int sid;
+} uvm_rpt_str_t;
+
+static FILE *uvm_rpt_fp = NULL;
+static unsigned char *uvm_rpt_buf = NULL;
+static size_t uvm_rpt_buf_len = 0;
+static int uvm_rpt_records = 0;
+static int uvm_rpt_atexit = 0;
+
+static uvm_rpt_str_t *uvm_rpt_strs = NULL;
+static unsigned int uvm_rpt_strs_size = 0;   // power of 2
+static unsigned int uvm_rpt_strs_used = 0;
+
+
+static unsigned int uvm_rpt_hash(const char *s)
+{
+  unsigned int h = 2166136261u;
+  while (*s) {
+    h ^= (unsigned char)*s++;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+
+static void uvm_rpt_flush()
+{
+  if (uvm_rpt_fp == NULL || uvm_rpt_buf_len == 0)
+    return;
+  if (fwrite(uvm_rpt_buf, 1, uvm_rpt_buf_len, uvm_rpt_fp) != uvm_rpt_buf_len)
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_report_stream: write error\n");
+  uvm_rpt_buf_len = 0;
+}
+
+
+static void uvm_rpt_put(const void *data, size_t len)
+{
+  const unsigned char *p = (const unsigned char*) data;
+
+  // Most puts are a few bytes and fit in the buffer
+  if (uvm_rpt_buf_len + len <= UVM_RPT_STREAM_BUF_SIZE) {
+    memcpy(uvm_rpt_buf + uvm_rpt_buf_len, p, len);
+    uvm_rpt_buf_len += len;
+    return;
+  }
+  while (len > 0) {
+    size_t n = UVM_RPT_STREAM_BUF_SIZE - uvm_rpt_buf_len;
+    if (n == 0) {
+      uvm_rpt_flush();
+      continue;
+    }
+    if (n > len)
+      n = len;
+    memcpy(uvm_rpt_buf + uvm_rpt_buf_len, p, n);
+    uvm_rpt_buf_len += n;
+    p += n;
+    len -= n;
+  }
+}
+
+
+static void uvm_rpt_put_u8(unsigned int v)
+{
+  unsigned char b = (unsigned char) v;
+  uvm_rpt_put(&b, 1);
+}
+
+
+static void uvm_rpt_put_u32(unsigned int v)
+{
+  unsigned char b[4];
+  b[0] = v & 0xff; b[1] = (v >> 8) & 0xff;
+  b[2] = (v >> 16) & 0xff; b[3] = (v >> 24) & 0xff;
+  uvm_rpt_put(b, 4);
+}
+
+
+static void uvm_rpt_put_u64(unsigned long long v)
+{
+  uvm_rpt_put_u32((unsigned int) (v & 0xffffffffu));
+  uvm_rpt_put_u32((unsigned int) (v >> 32));
+}
+
+
+static void uvm_rpt_strs_free()
+{
+  unsigned int i;
+  for (i = 0; i < uvm_rpt_strs_size; i++)
+    if (uvm_rpt_strs[i].str != NULL)
+      free(uvm_rpt_strs[i].str);
+  free(uvm_rpt_strs);
+  uvm_rpt_strs = NULL;
+  uvm_rpt_strs_size = 0;
+  uvm_rpt_strs_used = 0;
+}
+
+
+static void uvm_rpt_strs_grow()
+{
+  uvm_rpt_str_t *old = uvm_rpt_strs;
+  unsigned int old_size = uvm_rpt_strs_size;
+  unsigned int i;
+
+  uvm_rpt_strs_size = (old_size == 0) ? 1024 : old_size * 2;
+  uvm_rpt_strs = (uvm_rpt_str_t*) calloc(uvm_rpt_strs_size, sizeof(uvm_rpt_str_t));
+
+  for (i = 0; i < old_size; i++) {
+    unsigned int j;
+    if (old[i].str == NULL)
+      continue;
+    j = old[i].hash & (uvm_rpt_strs_size - 1);
+    while (uvm_rpt_strs[j].str != NULL)
+      j = (j + 1) & (uvm_rpt_strs_size - 1);
+    uvm_rpt_strs[j] = old[i];
+  }
+  free(old);
+}
+
+
+/*
+ * Return the id of string 's', emitting a STR record the first
+ * time it is seen on the current stream.
+ */
+static unsigned int uvm_rpt_intern(const char *s)
+{
+  unsigned int h, j, len;
+
+  if (s == NULL)
+    s = "";
+
+  if (2 * (uvm_rpt_strs_used + 1) > uvm_rpt_strs_size)
+    uvm_rpt_strs_grow();
+
+  h = uvm_rpt_hash(s);
+  j = h & (uvm_rpt_strs_size - 1);
+  while (uvm_rpt_strs[j].str != NULL) {
+    if (uvm_rpt_strs[j].hash == h && strcmp(uvm_rpt_strs[j].str, s) == 0)
+      return uvm_rpt_strs[j].sid;
+    j = (j + 1) & (uvm_rpt_strs_size - 1);
+  }
+
+  len = strlen(s);
+  uvm_rpt_strs[j].str = (char*) malloc(len + 1);
+  memcpy(uvm_rpt_strs[j].str, s, len + 1);
+  uvm_rpt_strs[j].hash = h;
+  uvm_rpt_strs[j].sid = uvm_rpt_strs_used++;
+
+  uvm_rpt_put_u8(UVM_RPT_STREAM_KIND_STR);
+  uvm_rpt_put_u32(len + 4);
+  uvm_rpt_put_u32(uvm_rpt_strs[j].sid);
+  uvm_rpt_put(s, len);
+
+  return uvm_rpt_strs[j].sid;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_report_stream_close
+//
+// Flushes and closes the current report stream, if any.
+//--------------------------------------------------------------------
+
+void uvm_report_stream_close()
+{
+  if (uvm_rpt_fp == NULL)
+    return;
+  uvm_rpt_flush();
+  fclose(uvm_rpt_fp);
+  uvm_rpt_fp = NULL;
+  free(uvm_rpt_buf);
+  uvm_rpt_buf = NULL;
+  uvm_rpt_strs_free();
+}
+
+
+//--------------------------------------------------------------------
+// uvm_report_stream_open
+//
+// Opens 'filename' as the report stream, closing any previously
+// opened stream. Returns 1 on success, 0 otherwise.
+//--------------------------------------------------------------------
+
+int uvm_report_stream_open(const char *filename)
+{
+  if (filename == NULL)
+    return 0;
+
+  uvm_report_stream_close();
+
+  uvm_rpt_fp = fopen(filename, "wb");
+  if (uvm_rpt_fp == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_report_stream_open: unable to open '%s'\n", filename);
+    return 0;
+  }
+
+  uvm_rpt_buf = (unsigned char*) malloc(UVM_RPT_STREAM_BUF_SIZE);
+  if (uvm_rpt_buf == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_report_stream_open: internal memory allocation error\n");
+    fclose(uvm_rpt_fp);
+    uvm_rpt_fp = NULL;
+    return 0;
+  }
+  uvm_rpt_buf_len = 0;
+  uvm_rpt_records = 0;
+
+  // A simulation may end on $finish without the stream being closed
+  if (!uvm_rpt_atexit) {
+    atexit(uvm_report_stream_close);
+    uvm_rpt_atexit = 1;
+  }
+
+  uvm_rpt_put("UVMRPTS", 8);
+  uvm_rpt_put_u32(UVM_RPT_STREAM_VERSION);
+  uvm_rpt_put_u32(0);
+
+  return 1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_report_stream_write
+//
+// Appends one report to the stream. Does nothing if no stream is open.
+//--------------------------------------------------------------------
+
+void uvm_report_stream_write(unsigned long long time, int severity,
+                             int verbosity, int action,
+                             const char *name, const char *id,
+                             const char *filename, int line,
+                             const char *message)
+{
+  unsigned int name_sid, id_sid, file_sid, msg_len;
+
+  if (uvm_rpt_fp == NULL)
+    return;
+
+  // Interning may emit STR records, so it must precede the MSG header
+  name_sid = uvm_rpt_intern(name);
+  id_sid   = uvm_rpt_intern(id);
+  file_sid = uvm_rpt_intern(filename);
+  msg_len  = (message == NULL) ? 0 : strlen(message);
+
+  uvm_rpt_put_u8(UVM_RPT_STREAM_KIND_MSG);
+  uvm_rpt_put_u32(UVM_RPT_STREAM_MSG_FIXED + msg_len);
+  uvm_rpt_put_u64(time);
+  uvm_rpt_put_u32(name_sid);
+  uvm_rpt_put_u32(id_sid);
+  uvm_rpt_put_u32(file_sid);
+  uvm_rpt_put_u32((unsigned int) line);
+  uvm_rpt_put_u32((unsigned int) verbosity);
+  uvm_rpt_put_u32((unsigned int) action);
+  uvm_rpt_put_u8((unsigned int) severity);
+  if (msg_len)
+    uvm_rpt_put(message, msg_len);
+
+  uvm_rpt_records++;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_report_stream_count
+//
+// Returns the number of reports written to the current stream,
+// or -1 if no stream is open.
+//--------------------------------------------------------------------
+
+int uvm_report_stream_count()
+{
+  if (uvm_rpt_fp == NULL)
+    return -1;
+  return uvm_rpt_records;
+}
+
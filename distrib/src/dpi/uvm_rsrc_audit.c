@@ -0,0 +1,231 @@
+//----------------------------------------------------------------------
+//   Copyright 2007-2011 Mentor Graphics Corporation
+//   Copyright 2007-2011 Cadence Design Systems, Inc.
+//   Copyright 2010-2011 Synopsys, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+#include <malloc.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "vpi_user.h"
+
+
+/*
+ * UVM resource audit file.
+ *
+ * When enabled with uvm_resource_pool::set_audit_file(), every get
+ * recorded by the resource pool audit trail is appended to a compact,
+ * length-prefixed binary file. Names and scopes are interned on the
+ * SystemVerilog side: each distinct string is written once as a STR
+ * record and referenced by its 32-bit id afterwards.
+ *
+ * File layout (all integers little-endian):
+ *
+ *   header : "UVMRSAU\0" u32 version u32 reserved
+ *   record : u8 kind u32 payload_len payload[payload_len]
+ *
+ *   kind 1 (STR) : u32 sid, bytes[payload_len-4]
+ *   kind 2 (GET) : u64 time, u32 name_sid, u32 scope_sid,
+ *                  u32 rsrc_scope_sid (0xffffffff: the get failed)
+ *
+ * The uvm_rsrc_audit_read utility (distrib/bin) reads this format.
+ */
+
+#define UVM_RSRC_AUDIT_VERSION   1
+#define UVM_RSRC_AUDIT_KIND_STR  1
+#define UVM_RSRC_AUDIT_KIND_GET  2
+#define UVM_RSRC_AUDIT_GET_SIZE  20
+#define UVM_RSRC_AUDIT_BUF_SIZE  (64*1024)
+
+static FILE *uvm_rsa_fp = NULL;
+static unsigned char *uvm_rsa_buf = NULL;
+static size_t uvm_rsa_buf_len = 0;
+static int uvm_rsa_records = 0;
+static int uvm_rsa_atexit = 0;
+
+
+static void uvm_rsa_flush()
+{
+  if (uvm_rsa_fp == NULL || uvm_rsa_buf_len == 0)
+    return;
+  if (fwrite(uvm_rsa_buf, 1, uvm_rsa_buf_len, uvm_rsa_fp) != uvm_rsa_buf_len)
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_rsrc_audit: write error\n");
+  uvm_rsa_buf_len = 0;
+}
+
+
+static void uvm_rsa_put(const void *data, size_t len)
+{
+  const unsigned char *p = (const unsigned char*) data;
+  while (len > 0) {
+    size_t n = UVM_RSRC_AUDIT_BUF_SIZE - uvm_rsa_buf_len;
+    if (n == 0) {
+      uvm_rsa_flush();
+      continue;
+    }
+    if (n > len)
+      n = len;
+    memcpy(uvm_rsa_buf + uvm_rsa_buf_len, p, n);
+    uvm_rsa_buf_len += n;
+    p += n;
+    len -= n;
+  }
+}
+
+
+static void uvm_rsa_put_u8(unsigned int v)
+{
+  unsigned char b = (unsigned char) v;
+  uvm_rsa_put(&b, 1);
+}
+
+
+static void uvm_rsa_put_u32(unsigned int v)
+{
+  unsigned char b[4];
+  b[0] = v & 0xff; b[1] = (v >> 8) & 0xff;
+  b[2] = (v >> 16) & 0xff; b[3] = (v >> 24) & 0xff;
+  uvm_rsa_put(b, 4);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_rsrc_audit_close
+//
+// Flushes and closes the audit file, if any.
+//--------------------------------------------------------------------
+
+void uvm_rsrc_audit_close()
+{
+  if (uvm_rsa_fp == NULL)
+    return;
+  uvm_rsa_flush();
+  fclose(uvm_rsa_fp);
+  uvm_rsa_fp = NULL;
+  free(uvm_rsa_buf);
+  uvm_rsa_buf = NULL;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_rsrc_audit_open
+//
+// Opens 'filename' as the audit file, closing any previously opened
+// file. Returns 1 on success, 0 otherwise.
+//--------------------------------------------------------------------
+
+int uvm_rsrc_audit_open(const char *filename)
+{
+  if (filename == NULL)
+    return 0;
+
+  uvm_rsrc_audit_close();
+
+  uvm_rsa_fp = fopen(filename, "wb");
+  if (uvm_rsa_fp == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_rsrc_audit_open: unable to open '%s'\n", filename);
+    return 0;
+  }
+
+  uvm_rsa_buf = (unsigned char*) malloc(UVM_RSRC_AUDIT_BUF_SIZE);
+  if (uvm_rsa_buf == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_rsrc_audit_open: internal memory allocation error\n");
+    fclose(uvm_rsa_fp);
+    uvm_rsa_fp = NULL;
+    return 0;
+  }
+  uvm_rsa_buf_len = 0;
+  uvm_rsa_records = 0;
+
+  // A simulation may end on $finish without the file being closed
+  if (!uvm_rsa_atexit) {
+    atexit(uvm_rsrc_audit_close);
+    uvm_rsa_atexit = 1;
+  }
+
+  uvm_rsa_put("UVMRSAU", 8);
+  uvm_rsa_put_u32(UVM_RSRC_AUDIT_VERSION);
+  uvm_rsa_put_u32(0);
+
+  return 1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_rsrc_audit_str
+//
+// Defines string 'sid' for the GET records that follow.
+//--------------------------------------------------------------------
+
+void uvm_rsrc_audit_str(int sid, const char *s)
+{
+  unsigned int len;
+
+  if (uvm_rsa_fp == NULL)
+    return;
+  if (s == NULL)
+    s = "";
+
+  len = strlen(s);
+  uvm_rsa_put_u8(UVM_RSRC_AUDIT_KIND_STR);
+  uvm_rsa_put_u32(len + 4);
+  uvm_rsa_put_u32((unsigned int) sid);
+  uvm_rsa_put(s, len);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_rsrc_audit_get
+//
+// Appends one get record. 'rsrc_sid' is -1 for a failed get.
+//--------------------------------------------------------------------
+
+void uvm_rsrc_audit_get(unsigned long long t, int name_sid,
+                        int scope_sid, int rsrc_sid)
+{
+  if (uvm_rsa_fp == NULL)
+    return;
+
+  uvm_rsa_put_u8(UVM_RSRC_AUDIT_KIND_GET);
+  uvm_rsa_put_u32(UVM_RSRC_AUDIT_GET_SIZE);
+  uvm_rsa_put_u32((unsigned int) (t & 0xffffffffu));
+  uvm_rsa_put_u32((unsigned int) (t >> 32));
+  uvm_rsa_put_u32((unsigned int) name_sid);
+  uvm_rsa_put_u32((unsigned int) scope_sid);
+  uvm_rsa_put_u32((unsigned int) rsrc_sid);
+
+  uvm_rsa_records++;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_rsrc_audit_count
+//
+// Returns the number of get records written to the open file,
+// or -1 if no file is open.
+//--------------------------------------------------------------------
+
+int uvm_rsrc_audit_count()
+{
+  if (uvm_rsa_fp == NULL)
+    return -1;
+  return uvm_rsa_records;
+}
+
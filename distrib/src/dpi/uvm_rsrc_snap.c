@@ -0,0 +1,549 @@
+//----------------------------------------------------------------------
+//   Copyright 2007-2011 Mentor Graphics Corporation
+//   Copyright 2007-2011 Cadence Design Systems, Inc.
+//   Copyright 2010-2011 Synopsys, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+#include <malloc.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "svdpi.h"
+#include "vpi_user.h"
+#include "uvm_dpi_array.h"
+
+
+/*
+ * UVM resource pool snapshot file.
+ *
+ * uvm_resource_snapshot::save() writes one record per resource of the
+ * pool whose type has a snapshot codec: its name, scope, codec tag,
+ * precedence, flags, positions in the name and type queues of the pool
+ * and its value, encoded by the codec as 32-bit words. Names, scopes and
+ * tags are interned: each distinct string is written once as a STR
+ * record and referenced by its 32-bit id afterwards. The leading zero
+ * words of values, e.g. of small uvm_bitstream_t values, are not
+ * written.
+ *
+ * File layout (all integers little-endian):
+ *
+ *   header : "UVMRSNP\0" u32 version u32 reserved
+ *   record : u8 kind u32 payload_len payload[payload_len]
+ *
+ *   kind 1 (STR)  : u32 sid, bytes[payload_len-4]
+ *   kind 2 (RSRC) : u32 name_sid, u32 scope_sid, u32 tag_sid,
+ *                   u32 precedence, u32 flags, u32 name_pos, u32 type_pos,
+ *                   u32 num_words, u32 words[(payload_len-32)/4]
+ *                   (the last words of the num_words value words)
+ *
+ * String ids are assigned in order from 0, so a snapshot with n STR
+ * records only uses ids below n. Values are at most
+ * UVM_RSRC_SNAP_MAX_WORDS words.
+ *
+ * A snapshot is read back in full by uvm_rsrc_snap_open() and its
+ * resources are then returned in file order by uvm_rsrc_snap_next().
+ */
+
+#define UVM_RSRC_SNAP_VERSION    1
+#define UVM_RSRC_SNAP_KIND_STR   1
+#define UVM_RSRC_SNAP_KIND_RSRC  2
+#define UVM_RSRC_SNAP_RSRC_FIXED 32
+#define UVM_RSRC_SNAP_BUF_SIZE   (256*1024)
+#define UVM_RSRC_SNAP_MAX_WORDS  (1 << 24)   // as in uvm_rsrc_snap.svh
+
+typedef struct uvm_rsn_str_s {
+  char *str;
+  unsigned int hash;
+  unsigned int sid;
+} uvm_rsn_str_t;
+
+// Writer
+static FILE *uvm_rsn_fp = NULL;
+static unsigned char *uvm_rsn_buf = NULL;
+static size_t uvm_rsn_buf_len = 0;
+static int uvm_rsn_werror = 0;
+static uvm_rsn_str_t *uvm_rsn_strs = NULL;
+static unsigned int uvm_rsn_strs_size = 0;   // power of 2
+static unsigned int uvm_rsn_strs_used = 0;
+static unsigned int *uvm_rsn_words = NULL;
+static int uvm_rsn_max_words = 0;
+
+// Reader
+static unsigned char *uvm_rsn_data = NULL;
+static size_t uvm_rsn_size = 0;
+static size_t uvm_rsn_pos = 0;
+static char **uvm_rsn_sids = NULL;
+static unsigned int uvm_rsn_num_sids = 0;
+static const unsigned char *uvm_rsn_cur = NULL;  // current RSRC payload
+static unsigned int uvm_rsn_cur_len = 0;
+
+
+static unsigned int uvm_rsn_hash(const char *s)
+{
+  unsigned int h = 2166136261u;
+  while (*s) {
+    h ^= (unsigned char)*s++;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+
+static void uvm_rsn_flush()
+{
+  if (uvm_rsn_fp == NULL || uvm_rsn_buf_len == 0)
+    return;
+  if (fwrite(uvm_rsn_buf, 1, uvm_rsn_buf_len, uvm_rsn_fp) != uvm_rsn_buf_len)
+    uvm_rsn_werror = 1;
+  uvm_rsn_buf_len = 0;
+}
+
+
+static void uvm_rsn_put(const void *data, size_t len)
+{
+  const unsigned char *p = (const unsigned char*) data;
+  while (len > 0) {
+    size_t n = UVM_RSRC_SNAP_BUF_SIZE - uvm_rsn_buf_len;
+    if (n == 0) {
+      uvm_rsn_flush();
+      continue;
+    }
+    if (n > len)
+      n = len;
+    memcpy(uvm_rsn_buf + uvm_rsn_buf_len, p, n);
+    uvm_rsn_buf_len += n;
+    p += n;
+    len -= n;
+  }
+}
+
+
+static void uvm_rsn_put_u8(unsigned int v)
+{
+  unsigned char b = (unsigned char) v;
+  uvm_rsn_put(&b, 1);
+}
+
+
+static void uvm_rsn_put_u32(unsigned int v)
+{
+  unsigned char b[4];
+  b[0] = v & 0xff; b[1] = (v >> 8) & 0xff;
+  b[2] = (v >> 16) & 0xff; b[3] = (v >> 24) & 0xff;
+  uvm_rsn_put(b, 4);
+}
+
+
+static unsigned int uvm_rsn_u32(const unsigned char *p)
+{
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int) p[3] << 24);
+}
+
+
+static void uvm_rsn_strs_grow()
+{
+  uvm_rsn_str_t *old = uvm_rsn_strs;
+  unsigned int old_size = uvm_rsn_strs_size;
+  unsigned int i;
+
+  uvm_rsn_strs_size = (old_size == 0) ? 1024 : old_size * 2;
+  uvm_rsn_strs = (uvm_rsn_str_t*) calloc(uvm_rsn_strs_size, sizeof(uvm_rsn_str_t));
+
+  for (i = 0; i < old_size; i++) {
+    unsigned int j;
+    if (old[i].str == NULL)
+      continue;
+    j = old[i].hash & (uvm_rsn_strs_size - 1);
+    while (uvm_rsn_strs[j].str != NULL)
+      j = (j + 1) & (uvm_rsn_strs_size - 1);
+    uvm_rsn_strs[j] = old[i];
+  }
+  free(old);
+}
+
+
+/*
+ * Return the id of string 's', emitting a STR record the first
+ * time it is seen.
+ */
+static unsigned int uvm_rsn_intern(const char *s)
+{
+  unsigned int h, j, len;
+
+  if (s == NULL)
+    s = "";
+
+  if (2 * (uvm_rsn_strs_used + 1) > uvm_rsn_strs_size)
+    uvm_rsn_strs_grow();
+
+  h = uvm_rsn_hash(s);
+  j = h & (uvm_rsn_strs_size - 1);
+  while (uvm_rsn_strs[j].str != NULL) {
+    if (uvm_rsn_strs[j].hash == h && strcmp(uvm_rsn_strs[j].str, s) == 0)
+      return uvm_rsn_strs[j].sid;
+    j = (j + 1) & (uvm_rsn_strs_size - 1);
+  }
+
+  len = strlen(s);
+  uvm_rsn_strs[j].str = (char*) malloc(len + 1);
+  memcpy(uvm_rsn_strs[j].str, s, len + 1);
+  uvm_rsn_strs[j].hash = h;
+  uvm_rsn_strs[j].sid = uvm_rsn_strs_used++;
+
+  uvm_rsn_put_u8(UVM_RSRC_SNAP_KIND_STR);
+  uvm_rsn_put_u32(len + 4);
+  uvm_rsn_put_u32(uvm_rsn_strs[j].sid);
+  uvm_rsn_put(s, len);
+
+  return uvm_rsn_strs[j].sid;
+}
+
+
+static void uvm_rsn_reader_free()
+{
+  free(uvm_rsn_data);
+  uvm_rsn_data = NULL;
+  uvm_rsn_size = 0;
+  uvm_rsn_pos = 0;
+  free(uvm_rsn_sids);   // entries point into uvm_rsn_data
+  uvm_rsn_sids = NULL;
+  uvm_rsn_num_sids = 0;
+  uvm_rsn_cur = NULL;
+  uvm_rsn_cur_len = 0;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_rsrc_snap_close
+//
+// Flushes and closes the snapshot being written, or releases the
+// snapshot being read. Returns 0 if the snapshot could not be
+// written completely, 1 otherwise.
+//--------------------------------------------------------------------
+
+int uvm_rsrc_snap_close()
+{
+  unsigned int i;
+  int ok = !uvm_rsn_werror;
+
+  uvm_rsn_reader_free();
+  if (uvm_rsn_fp == NULL)
+    return 1;
+
+  uvm_rsn_flush();
+  if (fclose(uvm_rsn_fp) != 0 || uvm_rsn_werror) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_rsrc_snap: write error\n");
+    ok = 0;
+  }
+  uvm_rsn_fp = NULL;
+  uvm_rsn_werror = 0;
+  free(uvm_rsn_buf);
+  uvm_rsn_buf = NULL;
+  for (i = 0; i < uvm_rsn_strs_size; i++)
+    free(uvm_rsn_strs[i].str);
+  free(uvm_rsn_strs);
+  uvm_rsn_strs = NULL;
+  uvm_rsn_strs_size = 0;
+  uvm_rsn_strs_used = 0;
+  return ok;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_rsrc_snap_create
+//
+// Creates 'filename' as a new snapshot, closing any open snapshot.
+// Returns 1 on success, 0 otherwise.
+//--------------------------------------------------------------------
+
+int uvm_rsrc_snap_create(const char *filename)
+{
+  if (filename == NULL)
+    return 0;
+
+  uvm_rsrc_snap_close();
+
+  uvm_rsn_fp = fopen(filename, "wb");
+  if (uvm_rsn_fp == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_rsrc_snap_create: unable to open '%s'\n", filename);
+    return 0;
+  }
+  uvm_rsn_buf = (unsigned char*) malloc(UVM_RSRC_SNAP_BUF_SIZE);
+  uvm_rsn_buf_len = 0;
+
+  uvm_rsn_put("UVMRSNP", 8);
+  uvm_rsn_put_u32(UVM_RSRC_SNAP_VERSION);
+  uvm_rsn_put_u32(0);
+  return 1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_rsrc_snap_put
+//
+// Appends one resource to the snapshot being written. The value is
+// the first 'num_words' elements of the int unsigned open array
+// 'words', most significant first.
+//--------------------------------------------------------------------
+
+void uvm_rsrc_snap_put(const char *name, const char *scope, const char *tag,
+                       unsigned int precedence, int flags,
+                       int name_pos, int type_pos,
+                       const svOpenArrayHandle words, int num_words)
+{
+  unsigned int name_sid, scope_sid, tag_sid;
+  const unsigned int *p;
+  int i, first;
+
+  if (uvm_rsn_fp == NULL)
+    return;
+  if (num_words < 0 || num_words > svSize(words, 1))
+    num_words = svSize(words, 1);
+  if (num_words > UVM_RSRC_SNAP_MAX_WORDS) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_rsrc_snap_put: the value of '%s' is %0d words, at most %0d can be saved\n",
+               name, num_words, UVM_RSRC_SNAP_MAX_WORDS);
+    uvm_rsn_werror = 1;
+    return;
+  }
+
+  p = (const unsigned int*) svGetArrayPtr(words);
+  if (p == NULL) {
+    if (num_words > uvm_rsn_max_words) {
+      unsigned int *w = (unsigned int*) realloc(uvm_rsn_words, num_words * sizeof(unsigned int));
+      if (w == NULL) {
+        vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_rsrc_snap_put: internal memory allocation error\n");
+        uvm_rsn_werror = 1;
+        return;
+      }
+      uvm_rsn_words = w;
+      uvm_rsn_max_words = num_words;
+    }
+    // The simulator does not store the array contiguously
+    uvm_dpi_array_get(words, uvm_rsn_words, num_words);
+    p = uvm_rsn_words;
+  }
+  for (first = 0; first < num_words && p[first] == 0; first++);
+
+  // Interning may emit STR records, so it must precede the RSRC header
+  name_sid  = uvm_rsn_intern(name);
+  scope_sid = uvm_rsn_intern(scope);
+  tag_sid   = uvm_rsn_intern(tag);
+
+  uvm_rsn_put_u8(UVM_RSRC_SNAP_KIND_RSRC);
+  uvm_rsn_put_u32(UVM_RSRC_SNAP_RSRC_FIXED + 4 * (num_words - first));
+  uvm_rsn_put_u32(name_sid);
+  uvm_rsn_put_u32(scope_sid);
+  uvm_rsn_put_u32(tag_sid);
+  uvm_rsn_put_u32(precedence);
+  uvm_rsn_put_u32((unsigned int) flags);
+  uvm_rsn_put_u32((unsigned int) name_pos);
+  uvm_rsn_put_u32((unsigned int) type_pos);
+  uvm_rsn_put_u32((unsigned int) num_words);
+  for (i = first; i < num_words; i++)
+    uvm_rsn_put_u32(p[i]);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_rsrc_snap_open
+//
+// Reads the snapshot 'filename', closing any open snapshot. Returns
+// the number of resources it holds, or -1 if it cannot be read.
+//--------------------------------------------------------------------
+
+int uvm_rsrc_snap_open(const char *filename)
+{
+  FILE *fp;
+  long size;
+  size_t pos;
+  unsigned int num_strs = 0, max_sid = 0;
+  int n = 0;
+
+  if (filename == NULL)
+    return -1;
+
+  uvm_rsrc_snap_close();
+
+  fp = fopen(filename, "rb");
+  if (fp == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_rsrc_snap_open: unable to open '%s'\n", filename);
+    return -1;
+  }
+  fseek(fp, 0, SEEK_END);
+  size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  uvm_rsn_data = (unsigned char*) malloc(size > 0 ? size : 1);
+  if (uvm_rsn_data == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_rsrc_snap_open: internal memory allocation error\n");
+    fclose(fp);
+    return -1;
+  }
+  if (size < 16 || fread(uvm_rsn_data, 1, size, fp) != (size_t) size ||
+      memcmp(uvm_rsn_data, "UVMRSNP", 8) != 0) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_rsrc_snap_open: '%s' is not a resource snapshot\n", filename);
+    fclose(fp);
+    uvm_rsn_reader_free();
+    return -1;
+  }
+  fclose(fp);
+  if (uvm_rsn_u32(uvm_rsn_data + 8) != UVM_RSRC_SNAP_VERSION) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_rsrc_snap_open: '%s' is a version %0u snapshot, version %0d expected\n",
+               filename, uvm_rsn_u32(uvm_rsn_data + 8), UVM_RSRC_SNAP_VERSION);
+    uvm_rsn_reader_free();
+    return -1;
+  }
+  uvm_rsn_size = size;
+
+  // Check the records once, so that uvm_rsrc_snap_next() can trust
+  // their lengths, string ids and value sizes
+  for (pos = 16; pos + 5 <= uvm_rsn_size; ) {
+    unsigned int kind = uvm_rsn_data[pos];
+    unsigned int len = uvm_rsn_u32(uvm_rsn_data + pos + 1);
+    int ok;
+
+    ok = (len <= uvm_rsn_size - pos - 5);
+    if (ok && kind == UVM_RSRC_SNAP_KIND_STR) {
+      ok = (len >= 4);
+      if (ok && uvm_rsn_u32(uvm_rsn_data + pos + 5) > max_sid)
+        max_sid = uvm_rsn_u32(uvm_rsn_data + pos + 5);
+      num_strs++;
+    }
+    else if (ok && kind == UVM_RSRC_SNAP_KIND_RSRC) {
+      unsigned int num_words;
+      ok = (len >= UVM_RSRC_SNAP_RSRC_FIXED);
+      if (ok) {
+        num_words = uvm_rsn_u32(uvm_rsn_data + pos + 5 + 28);
+        ok = (num_words <= UVM_RSRC_SNAP_MAX_WORDS &&
+              (len - UVM_RSRC_SNAP_RSRC_FIXED) / 4 <= num_words);
+      }
+      n++;
+    }
+    if (!ok) {
+      vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_rsrc_snap_open: '%s' is truncated or corrupted\n", filename);
+      uvm_rsn_reader_free();
+      return -1;
+    }
+    pos += 5 + len;
+  }
+  if (num_strs > 0 && max_sid >= num_strs) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_rsrc_snap_open: '%s' is truncated or corrupted\n", filename);
+    uvm_rsn_reader_free();
+    return -1;
+  }
+
+  uvm_rsn_sids = (char**) calloc(num_strs > 0 ? num_strs : 1, sizeof(char*));
+  if (uvm_rsn_sids == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_rsrc_snap_open: internal memory allocation error\n");
+    uvm_rsn_reader_free();
+    return -1;
+  }
+  uvm_rsn_num_sids = num_strs;
+  uvm_rsn_size = pos;
+  uvm_rsn_pos = 16;
+  return n;
+}
+
+
+static const char *uvm_rsn_sid(unsigned int sid)
+{
+  return (sid < uvm_rsn_num_sids && uvm_rsn_sids[sid] != NULL) ? uvm_rsn_sids[sid] : "";
+}
+
+
+//--------------------------------------------------------------------
+// uvm_rsrc_snap_next
+//
+// Moves to the next resource of the snapshot being read and returns
+// its attributes, or returns 0 if there is none left. Its value is
+// then retrieved with uvm_rsrc_snap_get_words.
+//--------------------------------------------------------------------
+
+int uvm_rsrc_snap_next(const char **name, const char **scope, const char **tag,
+                       unsigned int *precedence, int *flags,
+                       int *name_pos, int *type_pos, int *num_words)
+{
+  while (uvm_rsn_data != NULL && uvm_rsn_pos + 5 <= uvm_rsn_size) {
+    unsigned int kind = uvm_rsn_data[uvm_rsn_pos];
+    unsigned int len = uvm_rsn_u32(uvm_rsn_data + uvm_rsn_pos + 1);
+    unsigned char *p = uvm_rsn_data + uvm_rsn_pos + 5;
+
+    uvm_rsn_pos += 5 + len;
+
+    if (kind == UVM_RSRC_SNAP_KIND_STR) {
+      // Open sized the table for the ids it checked
+      unsigned int sid = uvm_rsn_u32(p);
+      if (sid >= uvm_rsn_num_sids)
+        continue;
+      // The string is moved over its sid to make room for the
+      // terminating NUL, which overwrites no other record
+      memmove(p, p + 4, len - 4);
+      p[len - 4] = '\0';
+      uvm_rsn_sids[sid] = (char*) p;
+      continue;
+    }
+    if (kind != UVM_RSRC_SNAP_KIND_RSRC)
+      continue;
+
+    *name       = uvm_rsn_sid(uvm_rsn_u32(p));
+    *scope      = uvm_rsn_sid(uvm_rsn_u32(p + 4));
+    *tag        = uvm_rsn_sid(uvm_rsn_u32(p + 8));
+    *precedence = uvm_rsn_u32(p + 12);
+    *flags      = (int) uvm_rsn_u32(p + 16);
+    *name_pos   = (int) uvm_rsn_u32(p + 20);
+    *type_pos   = (int) uvm_rsn_u32(p + 24);
+    *num_words  = (int) uvm_rsn_u32(p + 28);
+    uvm_rsn_cur = p;
+    uvm_rsn_cur_len = len;
+    return 1;
+  }
+  uvm_rsn_cur = NULL;
+  return 0;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_rsrc_snap_get_words
+//
+// Copies the value of the current resource into the int unsigned open
+// array 'words', which must hold its num_words elements.
+//--------------------------------------------------------------------
+
+void uvm_rsrc_snap_get_words(const svOpenArrayHandle words)
+{
+  unsigned int num_words, stored, i;
+  int lo, size;
+  const unsigned char *p;
+
+  if (uvm_rsn_cur == NULL)
+    return;
+  num_words = uvm_rsn_u32(uvm_rsn_cur + 28);
+  stored = (uvm_rsn_cur_len - UVM_RSRC_SNAP_RSRC_FIXED) / 4;
+  p = uvm_rsn_cur + UVM_RSRC_SNAP_RSRC_FIXED;
+  size = svSize(words, 1);
+  lo = svLow(words, 1);
+  if (stored > num_words || (int) num_words > size) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_rsrc_snap_get_words: %0d words requested, array holds %0d\n",
+               num_words, size);
+    return;
+  }
+  for (i = 0; i < num_words; i++) {
+    unsigned int w = (i < num_words - stored) ? 0 : uvm_rsn_u32(p + 4 * (i - (num_words - stored)));
+    *(unsigned int*) svGetArrElemPtr1(words, lo + i) = w;
+  }
+}
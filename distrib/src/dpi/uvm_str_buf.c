@@ -0,0 +1,231 @@
+//----------------------------------------------------------------------
+//   Copyright 2007-2011 Mentor Graphics Corporation
+//   Copyright 2007-2011 Cadence Design Systems, Inc.
+//   Copyright 2010-2011 Synopsys, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+#include <malloc.h>
+#include <string.h>
+#include <stdlib.h>
+#include "vpi_user.h"
+
+
+/*
+ * Native growable string buffers.
+ *
+ * Printers format their output into one of these buffers instead of
+ * growing a SystemVerilog string with repeated concatenation, which
+ * copies the whole string on every append. Buffers are referred to
+ * by small integer handles; freed handles are reused.
+ */
+
+#define UVM_STR_BUF_MIN_CAP  1024
+#define UVM_STR_BUF_KEEP_CAP (64*1024)
+
+typedef struct uvm_str_buf_s {
+  char *data;
+  int len;
+  int cap;     // 0 if the handle is free
+} uvm_str_buf_t;
+
+static uvm_str_buf_t *uvm_str_bufs = NULL;
+static int uvm_str_bufs_size = 0;
+
+
+static uvm_str_buf_t *uvm_str_buf_lookup(int h)
+{
+  if (h < 0 || h >= uvm_str_bufs_size || uvm_str_bufs[h].cap == 0) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_str_buf: invalid buffer handle %0d\n", h);
+    return NULL;
+  }
+  return &uvm_str_bufs[h];
+}
+
+
+static int uvm_str_buf_reserve(uvm_str_buf_t *b, int extra)
+{
+  int cap;
+  char *data;
+
+  if (b->len + extra + 1 <= b->cap)
+    return 1;
+  cap = b->cap;
+  while (cap < b->len + extra + 1)
+    cap *= 2;
+  data = (char*) realloc(b->data, cap);
+  if (data == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_str_buf: internal memory allocation error\n");
+    return 0;
+  }
+  b->data = data;
+  b->cap = cap;
+  return 1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_str_buf_new
+//
+// Allocates an empty buffer and returns its handle, or -1 on failure.
+//--------------------------------------------------------------------
+
+int uvm_str_buf_new()
+{
+  int h;
+
+  for (h = 0; h < uvm_str_bufs_size; h++)
+    if (uvm_str_bufs[h].cap == 0)
+      break;
+
+  if (h == uvm_str_bufs_size) {
+    int size = (uvm_str_bufs_size == 0) ? 8 : uvm_str_bufs_size * 2;
+    uvm_str_buf_t *bufs = (uvm_str_buf_t*) realloc(uvm_str_bufs, size * sizeof(uvm_str_buf_t));
+    if (bufs == NULL) {
+      vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_str_buf_new: internal memory allocation error\n");
+      return -1;
+    }
+    memset(bufs + uvm_str_bufs_size, 0, (size - uvm_str_bufs_size) * sizeof(uvm_str_buf_t));
+    uvm_str_bufs = bufs;
+    uvm_str_bufs_size = size;
+  }
+
+  uvm_str_bufs[h].data = (char*) malloc(UVM_STR_BUF_MIN_CAP);
+  if (uvm_str_bufs[h].data == NULL) {
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_str_buf_new: internal memory allocation error\n");
+    return -1;
+  }
+  uvm_str_bufs[h].data[0] = '\0';
+  uvm_str_bufs[h].len = 0;
+  uvm_str_bufs[h].cap = UVM_STR_BUF_MIN_CAP;
+  return h;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_str_buf_free
+//
+// Releases buffer 'h'. The handle may be returned by a later
+// uvm_str_buf_new.
+//--------------------------------------------------------------------
+
+void uvm_str_buf_free(int h)
+{
+  uvm_str_buf_t *b = uvm_str_buf_lookup(h);
+  if (b == NULL)
+    return;
+  free(b->data);
+  b->data = NULL;
+  b->len = 0;
+  b->cap = 0;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_str_buf_clear
+//
+// Empties buffer 'h', releasing memory beyond a modest capacity.
+//--------------------------------------------------------------------
+
+void uvm_str_buf_clear(int h)
+{
+  uvm_str_buf_t *b = uvm_str_buf_lookup(h);
+  if (b == NULL)
+    return;
+  if (b->cap > UVM_STR_BUF_KEEP_CAP) {
+    char *data = (char*) realloc(b->data, UVM_STR_BUF_KEEP_CAP);
+    if (data != NULL) {
+      b->data = data;
+      b->cap = UVM_STR_BUF_KEEP_CAP;
+    }
+  }
+  b->len = 0;
+  b->data[0] = '\0';
+}
+
+
+//--------------------------------------------------------------------
+// uvm_str_buf_put
+//
+// Appends 's' to buffer 'h' and returns the new length.
+//--------------------------------------------------------------------
+
+int uvm_str_buf_put(int h, const char *s)
+{
+  int n;
+  uvm_str_buf_t *b = uvm_str_buf_lookup(h);
+  if (b == NULL)
+    return 0;
+  if (s == NULL)
+    return b->len;
+  n = strlen(s);
+  if (!uvm_str_buf_reserve(b, n))
+    return b->len;
+  memcpy(b->data + b->len, s, n + 1);
+  b->len += n;
+  return b->len;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_str_buf_fill
+//
+// Appends 'n' copies of character 'c' to buffer 'h' and returns
+// the new length.
+//--------------------------------------------------------------------
+
+int uvm_str_buf_fill(int h, char c, int n)
+{
+  uvm_str_buf_t *b = uvm_str_buf_lookup(h);
+  if (b == NULL)
+    return 0;
+  if (n <= 0 || !uvm_str_buf_reserve(b, n))
+    return b->len;
+  memset(b->data + b->len, c, n);
+  b->len += n;
+  b->data[b->len] = '\0';
+  return b->len;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_str_buf_len
+//
+// Returns the current length of buffer 'h'.
+//--------------------------------------------------------------------
+
+int uvm_str_buf_len(int h)
+{
+  uvm_str_buf_t *b = uvm_str_buf_lookup(h);
+  return (b == NULL) ? 0 : b->len;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_str_buf_get
+//
+// Returns the contents of buffer 'h'. The pointer remains valid
+// until the buffer is next modified.
+//--------------------------------------------------------------------
+
+const char *uvm_str_buf_get(int h)
+{
+  uvm_str_buf_t *b = uvm_str_buf_lookup(h);
+  return (b == NULL) ? "" : b->data;
+}
+
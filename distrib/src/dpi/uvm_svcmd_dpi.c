@@ -26,6 +26,7 @@
 #include <regex.h>
 #include <assert.h>
 #include "vpi_user.h"
+#include "uvm_dpi_profile.h"
 
 #define ARGV_STACK_PTR_SIZE 32
 
@@ -52,6 +53,7 @@ extern const char *dpi_get_next_arg_c ()
       if (argv_stack_ptr == 0)
       {
 	// reset stack for next time
+	free(argv_stack);
 	argv_stack = NULL;
         argv_stack_ptr = 0;
 	// return completion
@@ -109,7 +111,10 @@ extern char* dpi_get_tool_version_c ()
 extern regex_t* dpi_regcomp (char* pattern)
 {
   regex_t* re = (regex_t*) malloc (sizeof(regex_t));
-  int status = regcomp(re, pattern, REG_NOSUB|REG_EXTENDED);
+  int status;
+  UVM_DPI_PROF_BEGIN;
+  status = regcomp(re, pattern, REG_NOSUB|REG_EXTENDED);
+  UVM_DPI_PROF_END(UVM_DPI_PROF_REGCOMP);
   if(status)
   {
     vpi_printf((char *)"Unable to compile regex: %s\n", pattern);
@@ -121,11 +126,17 @@ extern regex_t* dpi_regcomp (char* pattern)
 
 extern int dpi_regexec (regex_t* re, char* str)
 {
+  int status;
   if(!re )
   {
     return 1;
   }
-  return regexec(re, str, (size_t)0, NULL, 0);
+  {
+    UVM_DPI_PROF_BEGIN;
+    status = regexec(re, str, (size_t)0, NULL, 0);
+    UVM_DPI_PROF_END(UVM_DPI_PROF_REGEXEC);
+  }
+  return status;
 }
 
 extern void dpi_regfree (regex_t* re)
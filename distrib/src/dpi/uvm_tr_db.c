@@ -0,0 +1,789 @@
+//----------------------------------------------------------------------
+//   Copyright 2007-2011 Mentor Graphics Corporation
+//   Copyright 2007-2011 Cadence Design Systems, Inc.
+//   Copyright 2010-2011 Synopsys, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+#include <malloc.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "vpi_user.h"
+
+
+/*
+ * UVM native transaction recording database.
+ *
+ * Backs uvm_dpi_recorder. A database named <db> is a set of buffered,
+ * append-only column files (all integers little-endian):
+ *
+ *   <db>.str  : string table       u32 sid, u32 len, bytes[len]
+ *   <db>.strm : streams            u32 stream_id, u32 name_sid,
+ *                                  u32 type_sid, u32 scope_sid
+ *   <db>.tr   : transaction events 40-byte rows:
+ *                                  u32 kind, u32 tr_id, u32 ref, u32 0,
+ *                                  u64 time, u32 s0, u32 s1, u32 s2, u32 s3
+ *   <db>.attr : attributes         u8 kind, then
+ *                  ADEF: u32 stream_id, u32 attr_id, u32 name_sid
+ *                  AVAL: u32 tr_id, u32 attr_id, u8 radix, u32 numbits,
+ *                        u32 aval/bval pairs for each 32-bit word
+ *                  ASTR: u32 tr_id, u32 attr_id, u32 len, bytes[len]
+ *   <db>.idx  : index block every UVM_TR_DB_INDEX_INTERVAL BEGIN rows
+ *                                  u32 first_tr_id, u32 tr_row,
+ *                                  u64 first_time, u64 attr_offset
+ *
+ * Every file starts with the 16-byte header "UVMTRDB\0" u32 version
+ * u32 file_kind. Attribute names are interned once per stream (ADEF);
+ * subsequent values only carry the 32-bit attribute id.
+ *
+ * Handles returned to SV come from a slab allocator and are recycled
+ * after free_tr; the tr_id written to the database is never reused.
+ */
+
+#define UVM_TR_DB_VERSION         1
+#define UVM_TR_DB_BUF_SIZE        (256*1024)
+#define UVM_TR_DB_SLAB_SIZE       4096
+#define UVM_TR_DB_INDEX_INTERVAL  1024
+
+#define UVM_TR_DB_FILE_STR   0
+#define UVM_TR_DB_FILE_STRM  1
+#define UVM_TR_DB_FILE_TR    2
+#define UVM_TR_DB_FILE_ATTR  3
+#define UVM_TR_DB_FILE_IDX   4
+#define UVM_TR_DB_NUM_FILES  5
+
+#define UVM_TR_DB_BEGIN  1
+#define UVM_TR_DB_END    2
+#define UVM_TR_DB_LINK   3
+#define UVM_TR_DB_FREE   4
+
+#define UVM_TR_DB_ADEF   1
+#define UVM_TR_DB_AVAL   2
+#define UVM_TR_DB_ASTR   3
+
+#define UVM_TR_DB_NO_ID  0xffffffffu   // not found, or out of memory
+
+#define UVM_TR_DB_KIND_NONE    0
+#define UVM_TR_DB_KIND_STREAM  1
+#define UVM_TR_DB_KIND_TR      2
+
+static const char *uvm_tr_db_suffix[UVM_TR_DB_NUM_FILES] =
+  { ".str", ".strm", ".tr", ".attr", ".idx" };
+
+
+typedef struct uvm_tr_db_file_s {
+  FILE *fp;
+  unsigned char *buf;
+  size_t len;
+  unsigned long long offset;  // logical offset of the next byte
+} uvm_tr_db_file_t;
+
+
+// Open-addressing string -> id table. Used for the global string
+// table and for the per-stream attribute dictionaries.
+typedef struct uvm_tr_db_dict_s {
+  char **keys;
+  unsigned int *hashes;
+  unsigned int *ids;
+  unsigned int size;   // power of 2
+  unsigned int used;
+} uvm_tr_db_dict_t;
+
+
+typedef struct uvm_tr_db_slot_s {
+  int kind;
+  unsigned int id;        // stream_id or tr_id written to the database
+  int stream;             // owning stream handle for transactions
+  int next_free;
+  uvm_tr_db_dict_t attrs; // attribute dictionary, streams only
+} uvm_tr_db_slot_t;
+
+
+static uvm_tr_db_file_t uvm_tr_db_files[UVM_TR_DB_NUM_FILES];
+static int uvm_tr_db_is_open = 0;
+static int uvm_tr_db_atexit = 0;
+
+static uvm_tr_db_dict_t uvm_tr_db_strs;
+
+static uvm_tr_db_slot_t **uvm_tr_db_slabs = NULL;
+static int uvm_tr_db_num_slabs = 0;
+static int uvm_tr_db_num_slots = 0;
+static int uvm_tr_db_free_list = 0;   // handle of first free slot, 0 if none
+
+static unsigned int uvm_tr_db_next_stream_id = 1;
+static unsigned int uvm_tr_db_next_tr_id = 1;
+static unsigned int uvm_tr_db_num_begins = 0;
+
+
+//--------------------------------------------------------------------
+// Buffered column files
+//--------------------------------------------------------------------
+
+static void uvm_tr_db_flush(uvm_tr_db_file_t *f)
+{
+  if (f->fp == NULL || f->len == 0)
+    return;
+  if (fwrite(f->buf, 1, f->len, f->fp) != f->len)
+    vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_tr_db: write error\n");
+  f->len = 0;
+}
+
+
+static void uvm_tr_db_put(uvm_tr_db_file_t *f, const void *data, size_t len)
+{
+  const unsigned char *p = (const unsigned char*) data;
+  f->offset += len;
+  if (f->len + len <= UVM_TR_DB_BUF_SIZE) {
+    memcpy(f->buf + f->len, p, len);
+    f->len += len;
+    return;
+  }
+  while (len > 0) {
+    size_t n = UVM_TR_DB_BUF_SIZE - f->len;
+    if (n == 0) {
+      uvm_tr_db_flush(f);
+      continue;
+    }
+    if (n > len)
+      n = len;
+    memcpy(f->buf + f->len, p, n);
+    f->len += n;
+    p += n;
+    len -= n;
+  }
+}
+
+
+static void uvm_tr_db_put_u8(uvm_tr_db_file_t *f, unsigned int v)
+{
+  unsigned char b = (unsigned char) v;
+  uvm_tr_db_put(f, &b, 1);
+}
+
+
+static void uvm_tr_db_put_u32(uvm_tr_db_file_t *f, unsigned int v)
+{
+  unsigned char b[4];
+  b[0] = v & 0xff; b[1] = (v >> 8) & 0xff;
+  b[2] = (v >> 16) & 0xff; b[3] = (v >> 24) & 0xff;
+  uvm_tr_db_put(f, b, 4);
+}
+
+
+static void uvm_tr_db_put_u64(uvm_tr_db_file_t *f, unsigned long long v)
+{
+  uvm_tr_db_put_u32(f, (unsigned int) (v & 0xffffffffu));
+  uvm_tr_db_put_u32(f, (unsigned int) (v >> 32));
+}
+
+
+//--------------------------------------------------------------------
+// Dictionaries
+//--------------------------------------------------------------------
+
+static unsigned int uvm_tr_db_hash(const char *s)
+{
+  unsigned int h = 2166136261u;
+  while (*s) {
+    h ^= (unsigned char)*s++;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+
+static void uvm_tr_db_dict_free(uvm_tr_db_dict_t *d)
+{
+  unsigned int i;
+  for (i = 0; i < d->size; i++)
+    if (d->keys[i] != NULL)
+      free(d->keys[i]);
+  free(d->keys);
+  free(d->hashes);
+  free(d->ids);
+  memset(d, 0, sizeof(*d));
+}
+
+
+static void uvm_tr_db_alloc_error(const char *fn)
+{
+  vpi_printf((PLI_BYTE8*) "UVM_ERROR: %s: internal memory allocation error\n", fn);
+}
+
+
+// Returns 0, leaving 'd' unchanged, if out of memory
+static int uvm_tr_db_dict_grow(uvm_tr_db_dict_t *d)
+{
+  uvm_tr_db_dict_t old = *d;
+  unsigned int i;
+
+  d->size   = (old.size == 0) ? 16 : old.size * 2;
+  d->keys   = (char**) calloc(d->size, sizeof(char*));
+  d->hashes = (unsigned int*) calloc(d->size, sizeof(unsigned int));
+  d->ids    = (unsigned int*) calloc(d->size, sizeof(unsigned int));
+  if (d->keys == NULL || d->hashes == NULL || d->ids == NULL) {
+    free(d->keys);
+    free(d->hashes);
+    free(d->ids);
+    *d = old;
+    return 0;
+  }
+
+  for (i = 0; i < old.size; i++) {
+    unsigned int j;
+    if (old.keys[i] == NULL)
+      continue;
+    j = old.hashes[i] & (d->size - 1);
+    while (d->keys[j] != NULL)
+      j = (j + 1) & (d->size - 1);
+    d->keys[j]   = old.keys[i];
+    d->hashes[j] = old.hashes[i];
+    d->ids[j]    = old.ids[i];
+  }
+  free(old.keys);
+  free(old.hashes);
+  free(old.ids);
+  return 1;
+}
+
+
+// Returns the id of 's' in 'd', or UVM_TR_DB_NO_ID if absent
+static unsigned int uvm_tr_db_dict_find(const uvm_tr_db_dict_t *d, const char *s)
+{
+  unsigned int h, j;
+
+  if (d->size == 0)
+    return UVM_TR_DB_NO_ID;
+  h = uvm_tr_db_hash(s);
+  j = h & (d->size - 1);
+  while (d->keys[j] != NULL) {
+    if (d->hashes[j] == h && strcmp(d->keys[j], s) == 0)
+      return d->ids[j];
+    j = (j + 1) & (d->size - 1);
+  }
+  return UVM_TR_DB_NO_ID;
+}
+
+
+/*
+ * Inserts 's', which must be absent from 'd', with id d->used.
+ * Returns the id, or UVM_TR_DB_NO_ID if out of memory.
+ */
+static unsigned int uvm_tr_db_dict_add(uvm_tr_db_dict_t *d, const char *s)
+{
+  unsigned int h, j, len;
+  char *key;
+
+  if (2 * (d->used + 1) > d->size && !uvm_tr_db_dict_grow(d))
+    return UVM_TR_DB_NO_ID;
+  len = strlen(s);
+  key = (char*) malloc(len + 1);
+  if (key == NULL)
+    return UVM_TR_DB_NO_ID;
+  memcpy(key, s, len + 1);
+
+  h = uvm_tr_db_hash(s);
+  j = h & (d->size - 1);
+  while (d->keys[j] != NULL)
+    j = (j + 1) & (d->size - 1);
+  d->keys[j] = key;
+  d->hashes[j] = h;
+  d->ids[j] = d->used++;
+  return d->ids[j];
+}
+
+
+// Returns the id of 's', or UVM_TR_DB_NO_ID if out of memory
+static unsigned int uvm_tr_db_intern(const char *s)
+{
+  unsigned int sid, len;
+  uvm_tr_db_file_t *f = &uvm_tr_db_files[UVM_TR_DB_FILE_STR];
+
+  if (s == NULL)
+    s = "";
+  sid = uvm_tr_db_dict_find(&uvm_tr_db_strs, s);
+  if (sid != UVM_TR_DB_NO_ID)
+    return sid;
+  sid = uvm_tr_db_dict_add(&uvm_tr_db_strs, s);
+  if (sid == UVM_TR_DB_NO_ID)
+    return sid;
+  len = strlen(s);
+  uvm_tr_db_put_u32(f, sid);
+  uvm_tr_db_put_u32(f, len);
+  uvm_tr_db_put(f, s, len);
+  return sid;
+}
+
+
+//--------------------------------------------------------------------
+// Handle slab allocator
+//--------------------------------------------------------------------
+
+static uvm_tr_db_slot_t *uvm_tr_db_slot(int handle)
+{
+  if (handle <= 0 || handle > uvm_tr_db_num_slots)
+    return NULL;
+  handle--;
+  return &uvm_tr_db_slabs[handle / UVM_TR_DB_SLAB_SIZE][handle % UVM_TR_DB_SLAB_SIZE];
+}
+
+
+// Returns 0 if out of memory
+static int uvm_tr_db_alloc(int kind)
+{
+  int handle;
+  uvm_tr_db_slot_t *s;
+
+  if (uvm_tr_db_free_list != 0) {
+    handle = uvm_tr_db_free_list;
+    s = uvm_tr_db_slot(handle);
+    uvm_tr_db_free_list = s->next_free;
+  }
+  else {
+    if (uvm_tr_db_num_slots == uvm_tr_db_num_slabs * UVM_TR_DB_SLAB_SIZE) {
+      uvm_tr_db_slot_t **slabs;
+      uvm_tr_db_slot_t *slab;
+
+      slabs = (uvm_tr_db_slot_t**) realloc(uvm_tr_db_slabs,
+                (uvm_tr_db_num_slabs + 1) * sizeof(uvm_tr_db_slot_t*));
+      if (slabs == NULL)
+        return 0;
+      uvm_tr_db_slabs = slabs;
+      slab = (uvm_tr_db_slot_t*) calloc(UVM_TR_DB_SLAB_SIZE, sizeof(uvm_tr_db_slot_t));
+      if (slab == NULL)
+        return 0;
+      uvm_tr_db_slabs[uvm_tr_db_num_slabs++] = slab;
+    }
+    handle = ++uvm_tr_db_num_slots;
+    s = uvm_tr_db_slot(handle);
+  }
+  if (s == NULL)
+    return 0;
+
+  memset(s, 0, sizeof(*s));
+  s->kind = kind;
+  return handle;
+}
+
+
+static void uvm_tr_db_release(int handle)
+{
+  uvm_tr_db_slot_t *s = uvm_tr_db_slot(handle);
+  if (s == NULL || s->kind == UVM_TR_DB_KIND_NONE)
+    return;
+  if (s->kind == UVM_TR_DB_KIND_STREAM)
+    uvm_tr_db_dict_free(&s->attrs);
+  s->kind = UVM_TR_DB_KIND_NONE;
+  s->next_free = uvm_tr_db_free_list;
+  uvm_tr_db_free_list = handle;
+}
+
+
+static void uvm_tr_db_put_row(unsigned int kind, unsigned int tr_id, unsigned int ref,
+                              unsigned long long t, unsigned int s0, unsigned int s1,
+                              unsigned int s2, unsigned int s3)
+{
+  uvm_tr_db_file_t *f = &uvm_tr_db_files[UVM_TR_DB_FILE_TR];
+  uvm_tr_db_put_u32(f, kind);
+  uvm_tr_db_put_u32(f, tr_id);
+  uvm_tr_db_put_u32(f, ref);
+  uvm_tr_db_put_u32(f, 0);
+  uvm_tr_db_put_u64(f, t);
+  uvm_tr_db_put_u32(f, s0);
+  uvm_tr_db_put_u32(f, s1);
+  uvm_tr_db_put_u32(f, s2);
+  uvm_tr_db_put_u32(f, s3);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_close
+//
+// Flushes and closes the recording database, if open.
+//--------------------------------------------------------------------
+
+void uvm_tr_db_close()
+{
+  int i;
+
+  if (!uvm_tr_db_is_open)
+    return;
+
+  for (i = 0; i < UVM_TR_DB_NUM_FILES; i++) {
+    uvm_tr_db_flush(&uvm_tr_db_files[i]);
+    if (uvm_tr_db_files[i].fp != NULL)
+      fclose(uvm_tr_db_files[i].fp);
+    free(uvm_tr_db_files[i].buf);
+    memset(&uvm_tr_db_files[i], 0, sizeof(uvm_tr_db_file_t));
+  }
+
+  for (i = 1; i <= uvm_tr_db_num_slots; i++)
+    uvm_tr_db_release(i);
+  for (i = 0; i < uvm_tr_db_num_slabs; i++)
+    free(uvm_tr_db_slabs[i]);
+  free(uvm_tr_db_slabs);
+  uvm_tr_db_slabs = NULL;
+  uvm_tr_db_num_slabs = 0;
+  uvm_tr_db_num_slots = 0;
+  uvm_tr_db_free_list = 0;
+
+  uvm_tr_db_dict_free(&uvm_tr_db_strs);
+  uvm_tr_db_is_open = 0;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_open
+//
+// Creates the recording database files named 'db' plus the column
+// suffixes. Returns 1 on success, 0 otherwise.
+//--------------------------------------------------------------------
+
+int uvm_tr_db_open(const char *db)
+{
+  int i;
+  size_t len;
+  char *path;
+
+  if (db == NULL)
+    return 0;
+
+  uvm_tr_db_close();
+
+  len = strlen(db);
+  path = (char*) malloc(len + 8);
+  if (path == NULL) {
+    uvm_tr_db_alloc_error("uvm_tr_db_open");
+    return 0;
+  }
+
+  for (i = 0; i < UVM_TR_DB_NUM_FILES; i++) {
+    uvm_tr_db_file_t *f = &uvm_tr_db_files[i];
+    memcpy(path, db, len);
+    strcpy(path + len, uvm_tr_db_suffix[i]);
+    f->fp = fopen(path, "wb");
+    f->buf = (unsigned char*) malloc(UVM_TR_DB_BUF_SIZE);
+    f->len = 0;
+    f->offset = 0;
+    if (f->fp == NULL || f->buf == NULL) {
+      if (f->fp == NULL)
+        vpi_printf((PLI_BYTE8*) "UVM_ERROR: uvm_tr_db_open: unable to open '%s'\n", path);
+      else
+        uvm_tr_db_alloc_error("uvm_tr_db_open");
+      free(path);
+      uvm_tr_db_is_open = 1;
+      uvm_tr_db_close();
+      return 0;
+    }
+    uvm_tr_db_put(f, "UVMTRDB", 8);
+    uvm_tr_db_put_u32(f, UVM_TR_DB_VERSION);
+    uvm_tr_db_put_u32(f, i);
+  }
+  free(path);
+
+  uvm_tr_db_next_stream_id = 1;
+  uvm_tr_db_next_tr_id = 1;
+  uvm_tr_db_num_begins = 0;
+  uvm_tr_db_is_open = 1;
+
+  // A simulation may end on $finish without the database being closed
+  if (!uvm_tr_db_atexit) {
+    atexit(uvm_tr_db_close);
+    uvm_tr_db_atexit = 1;
+  }
+
+  return 1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_create_stream
+//
+// Returns a handle to a new stream, or 0 if the database is not open.
+//--------------------------------------------------------------------
+
+int uvm_tr_db_create_stream(const char *name, const char *t, const char *scope)
+{
+  int handle;
+  uvm_tr_db_slot_t *s;
+  uvm_tr_db_file_t *f = &uvm_tr_db_files[UVM_TR_DB_FILE_STRM];
+  unsigned int name_sid, type_sid, scope_sid;
+
+  if (!uvm_tr_db_is_open)
+    return 0;
+
+  name_sid  = uvm_tr_db_intern(name);
+  type_sid  = uvm_tr_db_intern(t);
+  scope_sid = uvm_tr_db_intern(scope);
+  handle = (name_sid == UVM_TR_DB_NO_ID || type_sid == UVM_TR_DB_NO_ID ||
+            scope_sid == UVM_TR_DB_NO_ID) ? 0 : uvm_tr_db_alloc(UVM_TR_DB_KIND_STREAM);
+  if (handle == 0) {
+    uvm_tr_db_alloc_error("uvm_tr_db_create_stream");
+    return 0;
+  }
+  s = uvm_tr_db_slot(handle);
+  s->id = uvm_tr_db_next_stream_id++;
+
+  uvm_tr_db_put_u32(f, s->id);
+  uvm_tr_db_put_u32(f, name_sid);
+  uvm_tr_db_put_u32(f, type_sid);
+  uvm_tr_db_put_u32(f, scope_sid);
+
+  return handle;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_begin_tr
+//
+// Returns a handle to a new transaction on 'stream', or 0 if the
+// database is not open or 'stream' is not a valid stream handle.
+//--------------------------------------------------------------------
+
+int uvm_tr_db_begin_tr(const char *txtype, int stream, const char *nm,
+                       const char *label, const char *desc,
+                       unsigned long long begin_time)
+{
+  int handle;
+  uvm_tr_db_slot_t *s;
+  uvm_tr_db_slot_t *strm = uvm_tr_db_slot(stream);
+  unsigned int type_sid, name_sid, label_sid, desc_sid;
+
+  if (!uvm_tr_db_is_open || strm == NULL || strm->kind != UVM_TR_DB_KIND_STREAM)
+    return 0;
+
+  type_sid  = uvm_tr_db_intern(txtype);
+  name_sid  = uvm_tr_db_intern(nm);
+  label_sid = uvm_tr_db_intern(label);
+  desc_sid  = uvm_tr_db_intern(desc);
+  handle = (type_sid == UVM_TR_DB_NO_ID || name_sid == UVM_TR_DB_NO_ID ||
+            label_sid == UVM_TR_DB_NO_ID || desc_sid == UVM_TR_DB_NO_ID)
+           ? 0 : uvm_tr_db_alloc(UVM_TR_DB_KIND_TR);
+  if (handle == 0) {
+    uvm_tr_db_alloc_error("uvm_tr_db_begin_tr");
+    return 0;
+  }
+  s = uvm_tr_db_slot(handle);
+  s->id = uvm_tr_db_next_tr_id++;
+  s->stream = stream;
+
+  if (uvm_tr_db_num_begins++ % UVM_TR_DB_INDEX_INTERVAL == 0) {
+    uvm_tr_db_file_t *f = &uvm_tr_db_files[UVM_TR_DB_FILE_IDX];
+    uvm_tr_db_put_u32(f, s->id);
+    uvm_tr_db_put_u32(f, (unsigned int)
+                      ((uvm_tr_db_files[UVM_TR_DB_FILE_TR].offset - 16) / 40));
+    uvm_tr_db_put_u64(f, begin_time);
+    uvm_tr_db_put_u64(f, uvm_tr_db_files[UVM_TR_DB_FILE_ATTR].offset);
+  }
+
+  uvm_tr_db_put_row(UVM_TR_DB_BEGIN, s->id, strm->id, begin_time,
+                    type_sid, name_sid, label_sid, desc_sid);
+  return handle;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_end_tr
+//--------------------------------------------------------------------
+
+void uvm_tr_db_end_tr(int handle, unsigned long long end_time)
+{
+  uvm_tr_db_slot_t *s = uvm_tr_db_slot(handle);
+  if (!uvm_tr_db_is_open || s == NULL || s->kind != UVM_TR_DB_KIND_TR)
+    return;
+  uvm_tr_db_put_row(UVM_TR_DB_END, s->id, 0, end_time, 0, 0, 0, 0);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_link_tr
+//--------------------------------------------------------------------
+
+void uvm_tr_db_link_tr(int h1, int h2, const char *relation,
+                       unsigned long long t)
+{
+  uvm_tr_db_slot_t *s1 = uvm_tr_db_slot(h1);
+  uvm_tr_db_slot_t *s2 = uvm_tr_db_slot(h2);
+  unsigned int rel_sid;
+  if (!uvm_tr_db_is_open || s1 == NULL || s2 == NULL ||
+      s1->kind != UVM_TR_DB_KIND_TR || s2->kind != UVM_TR_DB_KIND_TR)
+    return;
+  rel_sid = uvm_tr_db_intern(relation);
+  if (rel_sid == UVM_TR_DB_NO_ID) {
+    uvm_tr_db_alloc_error("uvm_tr_db_link_tr");
+    return;
+  }
+  uvm_tr_db_put_row(UVM_TR_DB_LINK, s1->id, s2->id, t, rel_sid, 0, 0, 0);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_free_tr
+//
+// Releases 'handle' for reuse. The transaction stays in the database.
+//--------------------------------------------------------------------
+
+void uvm_tr_db_free_tr(int handle, unsigned long long t)
+{
+  uvm_tr_db_slot_t *s = uvm_tr_db_slot(handle);
+  if (!uvm_tr_db_is_open || s == NULL || s->kind != UVM_TR_DB_KIND_TR)
+    return;
+  uvm_tr_db_put_row(UVM_TR_DB_FREE, s->id, 0, t, 0, 0, 0, 0);
+  uvm_tr_db_release(handle);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_check_handle
+//
+// Returns 1 for a stream handle, 2 for a transaction handle and 0 for
+// anything else.
+//--------------------------------------------------------------------
+
+int uvm_tr_db_check_handle(int handle)
+{
+  uvm_tr_db_slot_t *s = uvm_tr_db_slot(handle);
+  if (!uvm_tr_db_is_open || s == NULL)
+    return UVM_TR_DB_KIND_NONE;
+  return s->kind;
+}
+
+
+/*
+ * Resolve the transaction id and per-stream attribute id for 'nm' on
+ * 'handle', emitting an ADEF row the first time 'nm' is seen on the
+ * stream. Returns 0 if 'handle' is not a live handle or if out of
+ * memory.
+ */
+static int uvm_tr_db_attr(int handle, const char *nm,
+                          unsigned int *tr_id, unsigned int *attr_id)
+{
+  uvm_tr_db_slot_t *s = uvm_tr_db_slot(handle);
+  uvm_tr_db_slot_t *strm;
+  unsigned int name_sid;
+  uvm_tr_db_file_t *f = &uvm_tr_db_files[UVM_TR_DB_FILE_ATTR];
+
+  if (!uvm_tr_db_is_open || s == NULL || s->kind == UVM_TR_DB_KIND_NONE)
+    return 0;
+
+  if (s->kind == UVM_TR_DB_KIND_STREAM) {
+    strm = s;
+    *tr_id = 0;
+  }
+  else {
+    strm = uvm_tr_db_slot(s->stream);
+    *tr_id = s->id;
+  }
+
+  if (nm == NULL)
+    nm = "";
+  *attr_id = uvm_tr_db_dict_find(&strm->attrs, nm);
+  if (*attr_id != UVM_TR_DB_NO_ID)
+    return 1;
+
+  name_sid = uvm_tr_db_intern(nm);
+  if (name_sid != UVM_TR_DB_NO_ID)
+    *attr_id = uvm_tr_db_dict_add(&strm->attrs, nm);
+  if (name_sid == UVM_TR_DB_NO_ID || *attr_id == UVM_TR_DB_NO_ID) {
+    uvm_tr_db_alloc_error("uvm_tr_db_set_attribute");
+    return 0;
+  }
+  uvm_tr_db_put_u8(f, UVM_TR_DB_ADEF);
+  uvm_tr_db_put_u32(f, strm->id);
+  uvm_tr_db_put_u32(f, *attr_id);
+  uvm_tr_db_put_u32(f, name_sid);
+  return 1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_set_attribute
+//
+// Records the low 'numbits' bits of the 1024-bit 'value' (DPI/VPI
+// vector format) as attribute 'nm' of 'handle'.
+//--------------------------------------------------------------------
+
+void uvm_tr_db_set_attribute(int handle, const char *nm, const p_vpi_vecval value,
+                             int radix, int numbits)
+{
+  unsigned int tr_id, attr_id;
+  int i, words;
+  uvm_tr_db_file_t *f = &uvm_tr_db_files[UVM_TR_DB_FILE_ATTR];
+
+  if (!uvm_tr_db_attr(handle, nm, &tr_id, &attr_id))
+    return;
+
+  if (numbits < 0)
+    numbits = 0;
+  if (numbits > 1024)
+    numbits = 1024;
+  words = (numbits + 31) / 32;
+
+  uvm_tr_db_put_u8(f, UVM_TR_DB_AVAL);
+  uvm_tr_db_put_u32(f, tr_id);
+  uvm_tr_db_put_u32(f, attr_id);
+  uvm_tr_db_put_u8(f, (unsigned int) radix);
+  uvm_tr_db_put_u32(f, (unsigned int) numbits);
+  for (i = 0; i < words; i++) {
+    unsigned int mask = 0xffffffffu;
+    if (i == words - 1 && (numbits % 32) != 0)
+      mask = (1u << (numbits % 32)) - 1;
+    uvm_tr_db_put_u32(f, value[i].aval & mask);
+    uvm_tr_db_put_u32(f, value[i].bval & mask);
+  }
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_set_attribute_string
+//
+// Records string 'value' as attribute 'nm' of 'handle'.
+//--------------------------------------------------------------------
+
+void uvm_tr_db_set_attribute_string(int handle, const char *nm, const char *value)
+{
+  unsigned int tr_id, attr_id, len;
+  uvm_tr_db_file_t *f = &uvm_tr_db_files[UVM_TR_DB_FILE_ATTR];
+
+  if (!uvm_tr_db_attr(handle, nm, &tr_id, &attr_id))
+    return;
+
+  len = (value == NULL) ? 0 : strlen(value);
+  uvm_tr_db_put_u8(f, UVM_TR_DB_ASTR);
+  uvm_tr_db_put_u32(f, tr_id);
+  uvm_tr_db_put_u32(f, attr_id);
+  uvm_tr_db_put_u32(f, len);
+  if (len)
+    uvm_tr_db_put(f, value, len);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_tr_db_count
+//
+// Returns the number of transactions recorded since the database was
+// opened, or -1 if it is not open.
+//--------------------------------------------------------------------
+
+int uvm_tr_db_count()
+{
+  if (!uvm_tr_db_is_open)
+    return -1;
+  return (int) uvm_tr_db_num_begins;
+}
+
@@ -0,0 +1,195 @@
+//---------------------------------------------------------------------- 
+//   Copyright 2010 Cadence Design Systems.
+//   Copyright 2010 Mentor Graphics Corporation
+//   All Rights Reserved Worldwide 
+// 
+//   Licensed under the Apache License, Version 2.0 (the 
+//   "License"); you may not use this file except in 
+//   compliance with the License.  You may obtain a copy of 
+//   the License at 
+// 
+//       http://www.apache.org/licenses/LICENSE-2.0 
+// 
+//   Unless required by applicable law or agreed to in 
+//   writing, software distributed under the License is 
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR 
+//   CONDITIONS OF ANY KIND, either express or implied.  See 
+//   the License for the specific language governing 
+//   permissions and limitations under the License. 
+//----------------------------------------------------------------------
+
+// Check that processed reports are appended to the binary report
+// stream, and that filtered reports are not. The stream is read back
+// and decoded, and each record is compared with the report issued.
+
+module top;
+
+import uvm_pkg::*;
+`include "uvm_macros.svh"
+
+class test extends uvm_test;
+   `uvm_component_utils(test)
+
+   bit failed;
+
+   // Reports issued, in order
+   typedef struct {
+      longint unsigned time_;
+      int              severity;
+      string           name;
+      string           id;
+      string           filename;
+      int              line;
+      string           message;
+   } rpt_t;
+   rpt_t exp[$];
+
+   function new(string name, uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   function void report_info(string id, string message, int verbosity, int line);
+      rpt_t r;
+      uvm_report_info(id, message, verbosity, "stream_test.sv", line);
+      if (verbosity > UVM_MEDIUM)
+         return;
+      r = '{$time, UVM_INFO, get_full_name(), id, "stream_test.sv", line, message};
+      exp.push_back(r);
+   endfunction
+
+   function void report_warning(string id, string message, int line);
+      rpt_t r;
+      uvm_report_warning(id, message, UVM_NONE, "other_file.sv", line);
+      r = '{$time, UVM_WARNING, get_full_name(), id, "other_file.sv", line, message};
+      exp.push_back(r);
+   endfunction
+
+   function void error(string msg);
+      `uvm_error("STREAM", msg)
+      failed = 1;
+   endfunction
+
+   // Little-endian integer of 'n' bytes, -1 on end of file
+   function longint get_int(int fd, int n);
+      longint unsigned v = 0;
+      for (int i = 0; i < n; i++) begin
+         int c = $fgetc(fd);
+         if (c < 0)
+            return -1;
+         v |= longint'(c) << (8*i);
+      end
+      return v;
+   endfunction
+
+   function string get_str(int fd, int n);
+      string s = "";
+      for (int i = 0; i < n; i++)
+         s = {s, string'(byte'($fgetc(fd)))};
+      return s;
+   endfunction
+
+   // Decodes the stream (see src/dpi/uvm_report_stream.c for the layout)
+   function void read_stream(string filename, ref rpt_t act[$]);
+      string strs[int unsigned];
+      string magic;
+      int    fd = $fopen(filename, "rb");
+
+      if (fd == 0) begin
+         error({"Unable to read back ", filename});
+         return;
+      end
+      magic = get_str(fd, 7);
+      if (magic != "UVMRPTS" || $fgetc(fd) != 0 || get_int(fd, 4) != 1 ||
+          get_int(fd, 4) != 0) begin
+         error("Bad report stream header");
+         $fclose(fd);
+         return;
+      end
+
+      forever begin
+         longint kind = get_int(fd, 1);
+         longint len;
+         if (kind < 0)
+            break;
+         len = get_int(fd, 4);
+         if (kind == 1) begin
+            int unsigned sid = get_int(fd, 4);
+            strs[sid] = get_str(fd, len - 4);
+         end
+         else if (kind == 2) begin
+            rpt_t r;
+            r.time_    = get_int(fd, 8);
+            r.name     = strs[get_int(fd, 4)];
+            r.id       = strs[get_int(fd, 4)];
+            r.filename = strs[get_int(fd, 4)];
+            r.line     = get_int(fd, 4);
+            void'(get_int(fd, 4));  // verbosity
+            void'(get_int(fd, 4));  // action
+            r.severity = get_int(fd, 1);
+            r.message  = get_str(fd, len - 33);
+            act.push_back(r);
+         end
+         else begin
+            error($sformatf("Unknown record kind %0d", kind));
+            break;
+         end
+      end
+      $fclose(fd);
+   endfunction
+
+   virtual task run_phase(uvm_phase phase);
+     uvm_report_server serv = uvm_report_server::get_server();
+     rpt_t act[$];
+
+     if (serv.get_report_stream_count() != -1)
+       error("Report stream open before being enabled");
+
+     if (!serv.set_report_stream("uvm_report.bin")) begin
+       error("Unable to open report stream");
+       return;
+     end
+
+     report_info("MSG1", "Some message", UVM_LOW, 10);
+     #10;
+     report_info("MSG2", "Another message", UVM_LOW, 20);
+     report_warning("MSG1", "Some warning", 30);
+     report_info("MSG1", "Some message again", UVM_LOW, 10);
+     // Filtered by verbosity: must not reach the stream
+     report_info("MSG3", "Filtered message", UVM_DEBUG, 40);
+
+     if (serv.get_report_stream_count() != exp.size())
+       error($sformatf("Expected %0d streamed reports, got %0d",
+                       exp.size(), serv.get_report_stream_count()));
+
+     void'(serv.set_report_stream(""));
+     if (serv.get_report_stream_count() != -1)
+       error("Report stream still open after being closed");
+
+     read_stream("uvm_report.bin", act);
+     if (act.size() != exp.size())
+       error($sformatf("Read back %0d reports instead of %0d", act.size(), exp.size()));
+     foreach (act[i]) begin
+       if (i >= exp.size())
+         break;
+       if (act[i] != exp[i])
+         error($sformatf("Report %0d read back as %0d %s %s %s:%0d @%0d \"%s\"", i,
+                         act[i].severity, act[i].name, act[i].id, act[i].filename,
+                         act[i].line, act[i].time_, act[i].message));
+     end
+   endtask
+
+   virtual function void report();
+     if (!failed)
+       $display("**** UVM TEST PASSED ****");
+     else
+       $display("**** UVM TEST FAILED ****");
+   endfunction
+endclass
+
+
+initial
+  begin
+     run_test();
+  end
+
+endmodule
@@ -0,0 +1,105 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// +UVM_DPI_PROFILE counts the calls to the DPI entry points, and
+// the counts can be queried, paused and reset.
+
+`include "uvm_macros.svh"
+module top;
+
+import uvm_pkg::*;
+
+class test extends uvm_test;
+   `uvm_component_utils(test)
+
+   function new(string name = "test", uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   function int find(string name);
+      for (int id = 0; id < uvm_dpi_profile_num(); id++)
+        if (uvm_dpi_profile_name(id) == name)
+          return id;
+      `uvm_error("Test", {"No profiled entry point named ", name})
+      return -1;
+   endfunction
+
+   virtual task run_phase(uvm_phase phase);
+      int              match, glob;
+      longint unsigned calls, sum;
+      string           re;
+
+      phase.raise_objection(this);
+
+      if (!uvm_dpi_profile_is_enabled())
+        `uvm_error("Test", "+UVM_DPI_PROFILE did not enable the DPI profile")
+
+      match = find("uvm_re_match");
+      glob = find("uvm_glob_to_re");
+
+      calls = uvm_dpi_profile_calls(match);
+      re = uvm_glob_to_re("top.env.*");
+      for (int i = 0; i < 100; i++)
+        void'(uvm_re_match(re, $sformatf("top.env.c%0d", i)));
+      if (uvm_dpi_profile_calls(match) != calls + 100)
+        `uvm_error("Test", $sformatf("%0d calls to uvm_re_match counted instead of 100",
+                                     uvm_dpi_profile_calls(match) - calls))
+      if (uvm_dpi_profile_calls(glob) == 0)
+        `uvm_error("Test", "The call to uvm_glob_to_re was not counted")
+
+      sum = 0;
+      for (int b = 0; b < uvm_dpi_profile_num_buckets(); b++)
+        sum += uvm_dpi_profile_bucket(match, b);
+      if (sum != uvm_dpi_profile_calls(match))
+        `uvm_error("Test", "Histogram does not add up to the number of calls")
+      if (uvm_dpi_profile_total_ns(match) < uvm_dpi_profile_max_ns(match))
+        `uvm_error("Test", "Total time is less than the longest call")
+
+      // Print the profile while it is enabled
+      _global_reporter.get_report_server().summarize();
+
+      uvm_dpi_profile_enable(0);
+      calls = uvm_dpi_profile_calls(match);
+      void'(uvm_re_match(re, "top.env"));
+      if (uvm_dpi_profile_calls(match) != calls)
+        `uvm_error("Test", "A call was counted while the profile is disabled")
+
+      uvm_dpi_profile_reset();
+      if (uvm_dpi_profile_calls(match) != 0 || uvm_dpi_profile_total_ns(match) != 0)
+        `uvm_error("Test", "Counts were not reset")
+
+      phase.drop_objection(this);
+   endtask
+
+   virtual function void report_phase(uvm_phase phase);
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   endfunction
+endclass
+
+
+initial run_test("test");
+
+endmodule
@@ -0,0 +1,118 @@
+//
+//------------------------------------------------------------------------------
+//   Copyright 2011 (Authors)
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//------------------------------------------------------------------------------
+
+// Record transactions through uvm_dpi_recorder and check handle
+// management, the recorded transaction count, and that the database
+// is shared by all recorder instances.
+
+module top;
+  import uvm_pkg::*;
+  `include "uvm_macros.svh"
+
+  class data extends uvm_sequence_item;
+    rand int addr, payload;
+    string kind = "WRITE";
+    `uvm_object_utils_begin(data)
+       `uvm_field_int(addr, UVM_DEFAULT)
+       `uvm_field_int(payload, UVM_DEFAULT)
+       `uvm_field_string(kind, UVM_DEFAULT)
+    `uvm_object_utils_end
+
+    function new(string name="data");
+       super.new(name);
+    endfunction
+  endclass
+
+  class test extends uvm_component;
+    `uvm_component_utils(test)
+
+    uvm_dpi_recorder rec;
+
+    function new(string name, uvm_component parent);
+      super.new(name,parent);
+      recording_detail = UVM_LOW;
+      rec = new;
+      rec.filename = "test_tr_db";
+      recorder = rec;
+    endfunction
+
+    task run_phase(uvm_phase phase);
+      data d;
+      integer h;
+      bit failed;
+
+      for (int i = 0; i < 100; i++) begin
+        d = new($sformatf("d%0d", i));
+        void'(d.randomize());
+        void'(begin_tr(d));
+        #1;
+        end_tr(d);
+      end
+
+      if (uvm_tr_db_count() != 100) begin
+        `uvm_error("TRDB", $sformatf("Expected 100 recorded transactions, got %0d",
+                                     uvm_tr_db_count()))
+        failed = 1;
+      end
+
+      // Freed transaction handles are recycled
+      h = rec.begin_tr("test", rec.create_stream("s", "TVM", "top"), "t");
+      if (rec.check_handle_kind("Transaction", h) != 1) begin
+        `uvm_error("TRDB", "begin_tr did not return a transaction handle")
+        failed = 1;
+      end
+      rec.end_tr(h);
+      rec.free_tr(h);
+      if (rec.check_handle_kind("Transaction", h) != 0) begin
+        `uvm_error("TRDB", "Freed handle is still a transaction handle")
+        failed = 1;
+      end
+
+      // Another instance uses the open database of the same name
+      begin
+        uvm_dpi_recorder rec2 = new("rec2");
+        rec2.filename = "test_tr_db";
+        if (!rec2.open_file() || uvm_tr_db_count() != 101) begin
+          `uvm_error("TRDB", "A second recorder did not share the open database")
+          failed = 1;
+        end
+
+        // Opening another database closes the shared one
+        rec2.filename = "test_tr_db2";
+        if (!rec2.open_file() || uvm_tr_db_count() != 0) begin
+          `uvm_error("TRDB", "A second recorder did not open its own database")
+          failed = 1;
+        end
+      end
+
+      // Closes the database, whichever instance opened it
+      rec.close_file();
+      if (uvm_tr_db_count() != -1) begin
+        `uvm_error("TRDB", "Database still open after close_file")
+        failed = 1;
+      end
+
+      if (!failed)
+        uvm_report_info("SUCCESS", "**** UVM TEST PASSED ****", UVM_NONE);
+    endtask
+  endclass
+
+  initial run_test();
+endmodule
@@ -0,0 +1,166 @@
+//
+//------------------------------------------------------------------------------
+//   Copyright 2011 (Authors)
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//------------------------------------------------------------------------------
+
+
+// Checks uvm_object_pool reuse, statistics, max_free, factory overrides,
+// the reset of recycled transactions and uvm_tlm_gp_pool payload array
+// reuse.
+
+module top;
+  import uvm_pkg::*;
+  `include "uvm_macros.svh"
+
+  class item extends uvm_sequence_item;
+    int data;
+    `uvm_object_utils(item)
+    function new(string name="item");
+      super.new(name);
+    endfunction
+  endclass
+
+  class big_item extends item;
+    `uvm_object_utils(big_item)
+    function new(string name="big_item");
+      super.new(name);
+    endfunction
+  endclass
+
+  class item_pool extends uvm_object_pool #(item);
+    int resets;
+    function new(string name="");
+      super.new(name);
+    endfunction
+    virtual function void reset(item obj);
+      obj.data = 0;
+      resets++;
+    endfunction
+  endclass
+
+  class test extends uvm_component;
+    `uvm_component_utils(test)
+
+    bit failed;
+
+    function new(string name, uvm_component parent);
+      super.new(name,parent);
+    endfunction
+
+    function void check(bit ok, string msg);
+      if (!ok) begin
+        failed = 1;
+        `uvm_error("POOLTEST", msg)
+      end
+    endfunction
+
+    task run_phase(uvm_phase phase);
+      item_pool p = new("p");
+      uvm_tlm_gp_pool gpp = uvm_tlm_gp_pool#()::get_global_pool();
+      uvm_factory factory = uvm_factory::get();
+      item a, b, c;
+      big_item bi;
+      uvm_tlm_generic_payload gp, gp2;
+      time no_time = -1;
+
+      phase.raise_objection(this);
+
+      // Plain reuse
+      a = p.acquire("a");
+      a.data = 5;
+      p.release(a);
+      check(p.resets == 1 && a.data == 0, "reset hook not called");
+      b = p.acquire("b");
+      check(b == a && b.get_name() == "b", "released object not reused");
+      c = p.acquire("c");
+      check(c != b, "object handed out twice");
+      check(p.get_num_allocated() == 2 && p.get_num_reused() == 1 &&
+            p.get_num_released() == 1 && p.get_num_free() == 0,
+            $sformatf("unexpected statistics %s", p.convert2string()));
+
+      // Bounded free list
+      p.max_free = 1;
+      p.release(b);
+      p.release(c);
+      check(p.get_num_free() == 1 && p.get_num_dropped() == 1, "max_free not honored");
+      p.max_free = -1;
+
+      // Instance override for one path only
+      factory.set_inst_override_by_type(item::get_type(), big_item::get_type(), "top.big.*");
+      a = p.acquire("f", "top.small");
+      check(!$cast(bi, a) && p.get_num_free() == 0, "instance override applied to the wrong path");
+      b = p.acquire("g", "top.big");
+      check($cast(bi, b), "instance override not honored");
+
+      p.release(a);
+      p.release(b);
+
+      // Type override: the free big_item is reused, the free item is not
+      factory.set_type_override_by_type(item::get_type(), big_item::get_type());
+      a = p.acquire("d");
+      check($cast(bi, a), "type override not honored by acquire");
+      check(p.get_num_free() == 1, "free item of the overridden type was reused");
+      p.release(a);
+      b = p.acquire("e");
+      check(b == a, "overridden type not reused");
+
+      // Recycled transactions wait for their events to trigger anew
+      a = p.acquire("t");
+      a.accept_tr();
+      void'(a.begin_tr());
+      a.end_tr();
+      p.release(a);
+      b = p.acquire("t");
+      check(b == a && b.get_accept_time() == no_time && b.get_begin_time() == no_time &&
+            b.get_end_time() == no_time, "transaction times not reset");
+      check(!b.end_event.is_on() && !b.begin_event.is_on(), "transaction events not reset");
+      fork
+        #10 b.end_tr();
+      join_none
+      b.end_event.wait_on();
+      check($time == 10, "end_event of a recycled transaction already on");
+
+      // Payload arrays are kept across recycling
+      gp = gpp.acquire("gp");
+      gp.set_write();
+      gp.set_address(64'h100);
+      gp.reserve_data(16);
+      gp.reserve_byte_enable(4);
+      check(gp.get_data_length() == 16 && gp.m_data.size() == 16, "reserve_data");
+      gpp.release(gp);
+      check(gp.get_address() == 0 && gp.is_read() == 0 && gp.is_write() == 0 &&
+            gp.get_data_length() == 0 && gp.get_byte_enable_length() == 0 &&
+            gp.get_response_status() == UVM_TLM_INCOMPLETE_RESPONSE, "payload not reset");
+      gp2 = gpp.acquire("gp2");
+      check(gp2 == gp, "payload not reused");
+      gp2.reserve_data(8);
+      check(gp2.m_data.size() == 16 && gp2.get_data_length() == 8, "data array reallocated");
+      gp2.reserve_data(32);
+      check(gp2.m_data.size() == 32 && gp2.get_data_length() == 32, "data array not grown");
+      phase.drop_objection(this);
+    endtask
+
+    function void report_phase(uvm_phase phase);
+      if (failed) $write("** UVM TEST FAILED **\n");
+      else $write("** UVM TEST PASSED **\n");
+    endfunction
+  endclass
+
+  initial run_test("test");
+
+endmodule
@@ -0,0 +1,119 @@
+//---------------------------------------------------------------------- 
+//   Copyright 2010-2011 Synopsys, Inc. 
+//   All Rights Reserved Worldwide 
+// 
+//   Licensed under the Apache License, Version 2.0 (the 
+//   "License"); you may not use this file except in 
+//   compliance with the License.  You may obtain a copy of 
+//   the License at 
+// 
+//       http://www.apache.org/licenses/LICENSE-2.0 
+// 
+//   Unless required by applicable law or agreed to in 
+//   writing, software distributed under the License is 
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR 
+//   CONDITIONS OF ANY KIND, either express or implied.  See 
+//   the License for the specific language governing 
+//   permissions and limitations under the License. 
+//----------------------------------------------------------------------
+
+// Check that the indexed find_all returns the same components, in the
+// same order, as a full traversal of the hierarchy.
+
+program top;
+
+import uvm_pkg::*;
+
+class comp extends uvm_component;
+  function new(string name, uvm_component parent);
+    super.new(name, parent);
+  endfunction
+endclass
+
+class test extends uvm_test;
+
+  `uvm_component_utils(test)
+
+  function new(string name, uvm_component parent = null);
+    super.new(name, parent);
+  endfunction
+
+  // Builds a small tree under ~parent~, with names chosen so that
+  // siblings sort around the hierarchy separator
+  function void build_tree(uvm_component parent, int depth);
+    string names[$] = '{"b", "b-x", "bb", "b_y", "a"};
+    if (depth == 0)
+      return;
+    foreach (names[i]) begin
+      comp c = new(names[i], parent);
+      build_tree(c, depth-1);
+    end
+  endfunction
+
+  function void build_phase(uvm_phase phase);
+    comp e;
+    e = new("env", this);
+    build_tree(e, 3);
+    e = new("env2", this);
+    build_tree(e, 2);
+  endfunction
+
+  int n_checks;
+  bit failed;
+
+  function void check(string pattern, uvm_component scope = null);
+    uvm_component got[$], exp[$];
+    uvm_root top = uvm_root::get();
+
+    top.find_all(pattern, got, scope);
+    top.m_find_all_recurse(pattern, exp, (scope == null) ? top : scope);
+
+    n_checks++;
+    if (got.size() != exp.size()) begin
+      `uvm_error("FINDALL", $sformatf("'%s' under '%s': %0d matches, expected %0d",
+                 pattern, (scope == null) ? "" : scope.get_full_name(),
+                 got.size(), exp.size()))
+      failed = 1;
+      return;
+    end
+    foreach (exp[i])
+      if (got[i] != exp[i]) begin
+        `uvm_error("FINDALL", $sformatf("'%s': match %0d is '%s', expected '%s'",
+                   pattern, i, got[i].get_full_name(), exp[i].get_full_name()))
+        failed = 1;
+        return;
+      end
+  endfunction
+
+  function void end_of_elaboration_phase(uvm_phase phase);
+    uvm_component scope;
+    string patterns[$] = '{
+      "*", "uvm_test_top.*", "uvm_test_top.env.*", "uvm_test_top.env.b*",
+      "uvm_test_top.env.b", "uvm_test_top.env.b.*.a", "*.b-x.*", "?vm_test_top.env2",
+      "uvm_test_top.env+", "uvm_test_top.env2.bb.b_y", "nothing.*", "",
+      "/^uvm_test_top\\.env2?\\.a$/", "uvm_test_top.env.a.a.a" };
+
+    foreach (patterns[i])
+      check(patterns[i]);
+
+    scope = uvm_root::get().find("uvm_test_top.env.b");
+    foreach (patterns[i])
+      check(patterns[i], scope);
+    check("*.env.b.a*", scope);
+    check("uvm_test_top.env.b", scope);
+    check("uvm_test_top.env.bb*", scope);
+    check("uvm_test_top.env2.*", scope);
+  endfunction
+
+  function void report_phase(uvm_phase phase);
+    if (failed || n_checks == 0)
+      $write("** UVM TEST FAILED **\n");
+    else
+      $write("** UVM TEST PASSED **\n");
+  endfunction
+
+endclass
+
+initial run_test();
+
+endprogram
@@ -0,0 +1,154 @@
+//---------------------------------------------------------------------- 
+//   Copyright 2010-2011 Synopsys, Inc. 
+//   All Rights Reserved Worldwide 
+// 
+//   Licensed under the Apache License, Version 2.0 (the 
+//   "License"); you may not use this file except in 
+//   compliance with the License.  You may obtain a copy of 
+//   the License at 
+// 
+//       http://www.apache.org/licenses/LICENSE-2.0 
+// 
+//   Unless required by applicable law or agreed to in 
+//   writing, software distributed under the License is 
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR 
+//   CONDITIONS OF ANY KIND, either express or implied.  See 
+//   the License for the specific language governing 
+//   permissions and limitations under the License. 
+//----------------------------------------------------------------------
+
+
+// Out-of-order comparator: keyed matching, digest mismatch detection,
+// timeout and max-outstanding handling.
+
+program top;
+
+import uvm_pkg::*;
+`include "uvm_macros.svh"
+
+class txn extends uvm_sequence_item;
+  int id;
+  int data;
+
+  `uvm_object_utils_begin(txn)
+    `uvm_field_int(id, UVM_DEFAULT)
+    `uvm_field_int(data, UVM_DEFAULT)
+  `uvm_object_utils_end
+
+  function new(string name = "txn");
+    super.new(name);
+  endfunction
+
+  function string convert2string();
+    return $sformatf("id=%0d data=%0d", id, data);
+  endfunction
+endclass
+
+class txn_key;
+  static function int key(txn t);
+    return t.id;
+  endfunction
+endclass
+
+class test extends uvm_test;
+
+  `uvm_component_utils(test)
+
+  uvm_out_of_order_class_comparator #(txn, int, txn_key) sb;
+  uvm_out_of_order_built_in_comparator #(int) ib;
+  uvm_analysis_port #(txn) exp, obs;
+  uvm_analysis_port #(int) iexp;
+
+  function new(string name, uvm_component parent = null);
+    super.new(name, parent);
+  endfunction
+
+  function void build_phase(uvm_phase phase);
+    sb = new("sb", this);
+    sb.timeout = 50;
+    sb.check_empty = 0;
+    ib = new("ib", this);
+    ib.max_outstanding = 3;
+    ib.check_empty = 0;
+    exp = new("exp", this);
+    obs = new("obs", this);
+    iexp = new("iexp", this);
+  endfunction
+
+  function void connect_phase(uvm_phase phase);
+    exp.connect(sb.before_export);
+    obs.connect(sb.after_export);
+    iexp.connect(ib.before_export);
+  endfunction
+
+  function txn mk(int id, int data);
+    mk = new;
+    mk.id = id;
+    mk.data = data;
+  endfunction
+
+  task run_phase(uvm_phase phase);
+    phase.raise_objection(this);
+
+    // Expected ids 0..9, plus one (99) that is never observed
+    for (int i = 0; i < 10; i++)
+      exp.write(mk(i, i*10));
+    exp.write(mk(99, 0));
+    // Two expected transactions with the same id complete in order
+    exp.write(mk(7, 1));
+
+    #10;
+    // Observed in reverse order; id 3 carries the wrong data
+    for (int i = 9; i >= 0; i--)
+      obs.write(mk(i, (i == 3) ? 31 : i*10));
+    obs.write(mk(7, 1));
+
+    // Built-in stream: five values with no counterpart, limit of three
+    for (int i = 0; i < 5; i++)
+      iexp.write(i);
+
+    #100;
+    phase.drop_objection(this);
+  endtask
+
+  function void report_phase(uvm_phase phase);
+    uvm_report_server svr;
+    bit failed;
+
+    svr = _global_reporter.get_report_server();
+
+    if (sb.m_matches != 10 || sb.m_mismatches != 1) begin
+      `uvm_error("TEST", $sformatf("sb: %0d matches, %0d mismatches; expected 10, 1",
+                                   sb.m_matches, sb.m_mismatches))
+      failed = 1;
+    end
+    if (sb.m_timeouts != 1 || sb.get_outstanding() != 0) begin
+      `uvm_error("TEST", $sformatf("sb: %0d timeouts, %0d outstanding; expected 1, 0",
+                                   sb.m_timeouts, sb.get_outstanding()))
+      failed = 1;
+    end
+    if (sb.m_max_occupancy != 12 || sb.m_min_latency != 10 || sb.m_max_latency != 10) begin
+      `uvm_error("TEST", $sformatf("sb: occupancy %0d, latency %0t..%0t; expected 12, 10..10",
+                                   sb.m_max_occupancy, sb.m_min_latency, sb.m_max_latency))
+      failed = 1;
+    end
+    if (ib.m_overflows != 2 || ib.get_outstanding() != 3) begin
+      `uvm_error("TEST", $sformatf("ib: %0d overflows, %0d outstanding; expected 2, 3",
+                                   ib.m_overflows, ib.get_outstanding()))
+      failed = 1;
+    end
+    if (svr.get_id_count("OOO_TIMEOUT") != 1 || svr.get_id_count("OOO_OVERFLOW") != 2 ||
+        svr.get_id_count("Comparator Mismatch") != 1)
+      failed = 1;
+
+    if (failed)
+      $write("** UVM TEST FAILED **\n");
+    else
+      $write("** UVM TEST PASSED **\n");
+  endfunction
+
+endclass
+
+initial run_test();
+
+endprogram
@@ -0,0 +1,51 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+/*
+ * Reference model of the test: the sum of the two fields of a packet.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// From dpi/uvm_refmodel.h
+typedef int (*uvm_refmodel_fn)(void *ctx,
+                               const unsigned int *in, int n_in,
+                               unsigned int *out, int max_out);
+int uvm_refmodel_register(const char *name, uvm_refmodel_fn fn, void *ctx);
+void test_refmodel_init();
+
+#ifdef __cplusplus
+}
+#endif
+
+static int test_sum(void *ctx, const unsigned int *in, int n_in,
+                    unsigned int *out, int max_out)
+{
+  if (n_in != 2 || max_out < 1)
+    return -1;
+  out[0] = in[0] + in[1];
+  return 1;
+}
+
+void test_refmodel_init()
+{
+  uvm_refmodel_register("test_sum", test_sum, 0);
+}
@@ -0,0 +1,169 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// The transactions written to a uvm_native_algorithmic_comparator are
+// transformed by a C reference model on worker threads, and compared in
+// order at the end of the time step, or after the set latency. The
+// reference model is set by the configuration database for a comparator
+// created by the factory, or by the constructor.
+
+`include "uvm_macros.svh"
+module top;
+
+import uvm_pkg::*;
+
+import "DPI-C" function void test_refmodel_init();
+
+
+class pkt extends uvm_object;
+   bit [31:0] a;
+   bit [31:0] b;
+
+   `uvm_object_utils_begin(pkt)
+      `uvm_field_int(a, UVM_ALL_ON)
+      `uvm_field_int(b, UVM_ALL_ON)
+   `uvm_object_utils_end
+
+   function new(string name = "pkt");
+      super.new(name);
+   endfunction
+endclass
+
+
+class sum extends uvm_object;
+   bit [31:0] s;
+
+   `uvm_object_utils_begin(sum)
+      `uvm_field_int(s, UVM_ALL_ON)
+   `uvm_object_utils_end
+
+   function new(string name = "sum");
+      super.new(name);
+   endfunction
+endclass
+
+
+class test extends uvm_test;
+   uvm_native_algorithmic_comparator #(pkt, sum) cmp, cmp_new;
+   uvm_analysis_port #(pkt) before_ap;
+   uvm_analysis_port #(sum) after_ap;
+
+   `uvm_component_utils(test)
+
+   function new(string name = "test", uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   virtual function void build_phase(uvm_phase phase);
+      test_refmodel_init();
+      // Factory-created and configured through the configuration database
+      uvm_config_db#(string)::set(this, "cmp", "model", "test_sum");
+      uvm_config_db#(int)::set(this, "cmp", "n_threads", 2);
+      uvm_config_db#(int)::set(this, "cmp", "max_words", 4);
+      cmp = uvm_native_algorithmic_comparator#(pkt, sum)::type_id::create("cmp", this);
+      // Configured by the constructor
+      cmp_new = new("cmp_new", this, "test_sum", 1, 4);
+      before_ap = new("before_ap", this);
+      after_ap = new("after_ap", this);
+   endfunction
+
+   virtual function void connect_phase(uvm_phase phase);
+      before_ap.connect(cmp.before_export);
+      after_ap.connect(cmp.after_export);
+   endfunction
+
+   function void send(bit [31:0] a, bit [31:0] b, bit [31:0] s);
+      pkt p = new;
+      sum e = new;
+      p.a = a;
+      p.b = b;
+      e.s = s;
+      after_ap.write(e);
+      before_ap.write(p);
+   endfunction
+
+   function void check(int pending, int matches, string what);
+      uvm_report_server svr = _global_reporter.get_report_server();
+      if (cmp.get_num_pending() != pending ||
+          svr.get_id_count("Comparator Match") != matches)
+        `uvm_error("Test", $sformatf("%0d pending and %0d matches instead of %0d and %0d %s",
+                                     cmp.get_num_pending(), svr.get_id_count("Comparator Match"),
+                                     pending, matches, what))
+   endfunction
+
+   virtual task run_phase(uvm_phase phase);
+      phase.raise_objection(this);
+
+      if (cmp.get_num_threads() != 2 || cmp_new.get_num_threads() != 1)
+        `uvm_error("Test", $sformatf("The reference models have %0d and %0d worker threads",
+                                     cmp.get_num_threads(), cmp_new.get_num_threads()))
+
+      // Compared at the end of the time step
+      #1;
+      for (int i = 0; i < 100; i++)
+        send(i, 1000 * i, 1001 * i);
+      check(100, 0, "in the time step they are written in");
+      #1;
+      check(0, 100, "in the next time step");
+
+      // Compared 5 time units later
+      cmp.set_latency(5);
+      for (int i = 0; i < 3; i++)
+        send(i, 7, i + 7);
+      #2;
+      send('hFFFF_FFFF, 2, 1);
+      #2;
+      check(4, 100, "before the latency");
+      #2;
+      check(1, 103, "after the latency of the first ones");
+      #2;
+      check(0, 104, "after the latency of the last one");
+
+      // Mismatch
+      send(1, 1, 3);
+
+      // Still pending at the end of the run phase
+      cmp.set_latency(1000);
+      send(40, 2, 42);
+
+      #10;
+      phase.drop_objection(this);
+   endtask
+
+   virtual function void report_phase(uvm_phase phase);
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      check(0, 105, "in the report phase");
+      if (svr.get_id_count("Comparator Mismatch") != 1)
+        `uvm_error("Test", $sformatf("%0d mismatches instead of 1",
+                                     svr.get_id_count("Comparator Mismatch")))
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   endfunction
+endclass
+
+
+initial run_test("test");
+
+endmodule
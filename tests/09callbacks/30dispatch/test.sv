@@ -0,0 +1,138 @@
+//---------------------------------------------------------------------
+//   Copyright 2010-2011 Mentor Graphics Corporation
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// Test: 30dispatch
+// Purpose: Checks that the callback macros see every change made through
+// add, delete and callback_mode between two executions, once their
+// dispatch table has been built.
+// API tested:
+//   `uvm_do_callbacks
+//   `uvm_do_callbacks_exit_on
+//      uvm_callbacks#(T,CB)::add(comp,cb);
+//      uvm_callbacks#(T,CB)::add(null,cb);
+//      uvm_callbacks#(T,CB)::delete(comp,cb);
+//      uvm_callback::callback_mode(0/1);
+
+module test;
+  import uvm_pkg::*;
+  `include "uvm_macros.svh"
+
+  virtual class cb_base extends uvm_callback;
+    function new(string name=""); super.new(name); endfunction
+    pure virtual function void doit(ref string q[$]);
+    pure virtual function bit veto();
+  endclass
+
+  class ip_comp extends uvm_component;
+    string q[$];
+    `uvm_component_utils(ip_comp)
+    `uvm_register_cb(ip_comp,cb_base)
+    function new(string name,uvm_component parent);
+      super.new(name,parent);
+    endfunction
+    function string run_cbs();
+      q.delete();
+      `uvm_do_callbacks(ip_comp,cb_base,doit(q))
+      run_cbs = "";
+      foreach (q[i]) run_cbs = {run_cbs, q[i], " "};
+    endfunction
+    function bit allowed();
+      `uvm_do_callbacks_exit_on(ip_comp,cb_base,veto(),0)
+    endfunction
+  endclass
+
+  class mycb extends cb_base;
+    bit allow = 1;
+    function new(string name=""); super.new(name); endfunction
+    virtual function void doit(ref string q[$]);
+      q.push_back(get_name());
+    endfunction
+    virtual function bit veto();
+      return allow;
+    endfunction
+  endclass
+
+  class test extends uvm_component;
+    ip_comp c1, c2;
+    bit failed;
+    `uvm_component_utils(test)
+
+    function new(string name,uvm_component parent);
+      super.new(name,parent);
+      c1 = new("c1",this);
+      c2 = new("c2",this);
+    endfunction
+
+    function void check(string what, string act, string exp);
+      if (act != exp) begin
+        $display("ERROR: %s: got \"%s\", expected \"%s\"", what, act, exp);
+        failed = 1;
+      end
+    endfunction
+
+    task run_phase(uvm_phase phase);
+      mycb a = new("a"), b = new("b"), t = new("t");
+
+      check("empty", c1.run_cbs(), "");
+      check("empty allowed", c1.allowed() ? "1" : "0", "1");
+
+      uvm_callbacks#(ip_comp,cb_base)::add(c1,a);
+      check("add", c1.run_cbs(), "a ");
+      check("other instance", c2.run_cbs(), "");
+
+      uvm_callbacks#(ip_comp,cb_base)::add(c1,b,UVM_PREPEND);
+      check("prepend", c1.run_cbs(), "b a ");
+
+      void'(a.callback_mode(0));
+      check("disable", c1.run_cbs(), "b ");
+      void'(a.callback_mode(0));
+      check("disable again", c1.run_cbs(), "b ");
+      void'(a.callback_mode(1));
+      check("enable", c1.run_cbs(), "b a ");
+
+      uvm_callbacks#(ip_comp,cb_base)::add(null,t);
+      check("typewide c1", c1.run_cbs(), "b a t ");
+      check("typewide c2", c2.run_cbs(), "t ");
+
+      uvm_callbacks#(ip_comp,cb_base)::delete(c1,b);
+      check("delete", c1.run_cbs(), "a t ");
+
+      uvm_callbacks#(ip_comp,cb_base)::delete(null,t);
+      check("delete typewide c1", c1.run_cbs(), "a ");
+      check("delete typewide c2", c2.run_cbs(), "");
+
+      a.allow = 0;
+      check("exit_on veto", c1.allowed() ? "1" : "0", "0");
+      void'(a.callback_mode(0));
+      check("exit_on disabled", c1.allowed() ? "1" : "0", "1");
+    endtask
+
+    function void report_phase(uvm_phase phase);
+      if(failed)
+        $write("** UVM TEST FAILED! **\n");
+      else
+        $write("** UVM TEST PASSED! **\n");
+    endfunction
+  endclass
+
+  initial begin
+    run_test();
+  end
+  
+endmodule
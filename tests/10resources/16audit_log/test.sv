@@ -0,0 +1,131 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// In the compact audit mode, accesses recorded by accessor handle are
+// reported by name like in the default mode, and are merged with the
+// accesses recorded before the mode was selected. Accessors past the
+// name limit share one "<other>" record.
+
+`include "uvm_macros.svh"
+module top;
+
+import uvm_pkg::*;
+
+class test extends uvm_component;
+   uvm_resource#(int) used, unused;
+
+   `uvm_component_utils(test)
+
+   function new(string name, uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   function void check_access(int exp_reads, int exp_writes);
+      uvm_resource_types::access_t a;
+      if (!used.access.exists(get_full_name())) begin
+         `uvm_error("Test", "No access record for the test component")
+         return;
+      end
+      a = used.access[get_full_name()];
+      if (a.read_count != exp_reads || a.write_count != exp_writes)
+        `uvm_error("Test", $sformatf("%0d reads and %0d writes recorded instead of %0d and %0d",
+                                     a.read_count, a.write_count, exp_reads, exp_writes))
+   endfunction
+
+   task run_phase(uvm_phase phase);
+      uvm_resource_pool rp = uvm_resource_pool::get();
+      uvm_resource_types::rsrc_q_t q;
+      bit found_used, found_unused;
+      int x;
+
+      phase.raise_objection(this);
+
+      used = new("used", "*");
+      unused = new("unused", "*");
+      used.set();
+      unused.set();
+
+      // Default audit mode
+      x = used.read(this);
+      used.write(1, this);
+
+      uvm_resource_options::set_audit_log_size(4);
+      if (uvm_resource_options::get_audit_log_size() != 4)
+        `uvm_error("Test", "Audit log size was not set")
+
+      for (int i = 0; i < 100; i++) begin
+         #1;
+         void'(uvm_resource_db#(int)::get_by_name("top", "used"));
+         void'(uvm_resource_db#(int)::get_by_name("top", "missing", 0));
+         x = used.read(this);
+      end
+      used.write(2, this);
+
+      // Only the last 4 get records are kept
+      rp.dump_get_records();
+
+      q = rp.find_unused_resources();
+      foreach (q[i]) begin
+         if (q[i] == used) found_used = 1;
+         if (q[i] == unused) found_unused = 1;
+      end
+      if (found_used)
+        `uvm_error("Test", "Resource read in compact audit mode is reported as unused")
+      if (!found_unused)
+        `uvm_error("Test", "Resource never read is not reported as unused")
+
+      check_access(101, 2);
+
+      // New accessor names past the limit fold into one record
+      uvm_resource_options::set_audit_max_names(0);
+      for (int i = 0; i < 10; i++) begin
+         uvm_sequence_item acc = new($sformatf("acc%0d", i));
+         x = used.read(acc);
+      end
+      uvm_resource_options::set_audit_max_names(65536);
+
+      // Back to the default audit mode
+      uvm_resource_options::set_audit_log_size(0);
+      x = used.read(this);
+      used.print_accessors();
+      check_access(102, 2);
+      if (!used.access.exists("<other>") || used.access["<other>"].read_count != 10)
+        `uvm_error("Test", "Accesses past the name limit are not in one <other> record")
+      if (used.access.exists("acc0"))
+        `uvm_error("Test", "An accessor past the name limit has its own record")
+
+      phase.drop_objection(this);
+   endtask
+
+   function void report_phase(uvm_phase phase);
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   endfunction
+endclass
+
+
+initial run_test("test");
+
+endmodule
@@ -0,0 +1,188 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// A resource snapshot reloaded in an empty pool rebuilds the name and
+// type queues in the same order, with the same values, precedences and
+// read-only states. Reloaded in a pool that has resources, the overrides
+// go to the front of the queues. Resources of a type without a codec are
+// not saved.
+
+`include "uvm_macros.svh"
+module top;
+
+import uvm_pkg::*;
+
+typedef enum {SLOW, FAST, TURBO} mode_e;
+
+class cfg extends uvm_object;
+   int unsigned n;
+   string       s;
+
+   `uvm_object_utils_begin(cfg)
+      `uvm_field_int(n, UVM_ALL_ON)
+      `uvm_field_string(s, UVM_ALL_ON)
+   `uvm_object_utils_end
+
+   function new(string name = "cfg");
+      super.new(name);
+   endfunction
+endclass
+
+
+function automatic string image(uvm_resource_base r);
+   return $sformatf("%s@%s prec=%0d ro=%0d %s", r.get_name(), r.get_scope(),
+                    r.precedence, r.is_read_only(), r.convert2string());
+endfunction
+
+
+// Compares the saved resources of ~exp~ with the resources of ~act~
+function automatic void check_q(string what, uvm_resource_types::rsrc_q_t exp,
+                                uvm_resource_types::rsrc_q_t act);
+   string e[$], a[$];
+   for (int i = 0; exp != null && i < exp.size(); i++)
+     if (exp.get(i).get_type_handle() != uvm_resource#(real)::get_type())
+       e.push_back(image(exp.get(i)));
+   for (int i = 0; act != null && i < act.size(); i++)
+     a.push_back(image(act.get(i)));
+   if (a != e) begin
+      `uvm_error("Test", $sformatf("%s has %0d resources instead of %0d:", what,
+                                   a.size(), e.size()))
+      foreach (a[i]) $display("   got      %s", a[i]);
+      foreach (e[i]) $display("   expected %s", e[i]);
+   end
+endfunction
+
+
+initial
+begin
+   uvm_resource_pool  rp = uvm_resource_pool::get();
+   uvm_resource_pool  p2 = new;
+   uvm_resource_pool  p3 = new;
+   cfg                c = new("top_cfg");
+   uvm_resource#(int) limit = new("limit", "*");
+   uvm_resource#(int) own = new("count", "*");
+   int                n;
+
+   uvm_resource_snap_scalar#(mode_e)::register();
+   uvm_resource_snap_object#(cfg)::register();
+
+   c.n = 42;
+   c.s = "hello";
+
+   uvm_config_db#(int)::set(null, "env.agent*", "count", 3);
+   uvm_config_db#(int)::set(null, "env.*", "count", 4);
+   uvm_resource_db#(int)::set("*", "count", 1);
+   uvm_resource_db#(int)::set_anonymous("env.*", 77);
+   uvm_config_db#(string)::set(null, "env", "label", "first");
+   uvm_config_db#(uvm_bitstream_t)::set(null, "env.agent", "width",
+                                        'h1_0000_0000_0000_00FF);
+   uvm_config_db#(mode_e)::set(null, "env", "mode", FAST);
+   uvm_config_db#(cfg)::set(null, "env", "cfg", c);
+   uvm_config_db#(uvm_object)::set(null, "env", "none", null);
+   uvm_config_db#(uvm_object_wrapper)::set(null, "env.sqr.main_phase",
+                                           "default_sequence", cfg::get_type());
+   uvm_resource_db#(real)::set("*", "ratio", 0.5);
+   limit.write(9);
+   limit.precedence = 2000;
+   limit.set_read_only();
+   limit.set();
+
+   n = uvm_resource_snapshot::save("snapshot.bin");
+   if (n < 10)
+     `uvm_error("Test", $sformatf("%0d resources saved", n))
+
+   // Reload in an empty pool
+   if (uvm_resource_snapshot::load("snapshot.bin", p2) != n)
+     `uvm_error("Test", "Not all saved resources were loaded")
+   if (!uvm_resource_snapshot::is_loaded())
+     `uvm_error("Test", "is_loaded() is 0 after a load")
+
+   foreach (rp.rtab[name])
+     check_q({"Name queue ", name}, rp.rtab[name],
+             p2.rtab.exists(name) ? p2.rtab[name] : null);
+   foreach (rp.ttab[t])
+     if (t != uvm_resource#(real)::get_type())
+       check_q({"Type queue of ", image(rp.ttab[t].get(0))}, rp.ttab[t],
+               p2.ttab.exists(t) ? p2.ttab[t] : null);
+   if (p2.rtab.exists("ratio") || p2.ttab.exists(uvm_resource#(real)::get_type()))
+     `uvm_error("Test", "Resource of a type without a codec was loaded")
+
+   begin
+      uvm_resource#(cfg)                rc;
+      uvm_resource#(mode_e)             rm;
+      uvm_resource#(uvm_bitstream_t)    rb;
+      uvm_resource#(uvm_object_wrapper) rw;
+      uvm_resource#(uvm_object)         ro;
+      uvm_resource#(int)                ri;
+      cfg                               c2;
+
+      $cast(rc, p2.get_by_name("env", "cfg", uvm_resource#(cfg)::get_type()));
+      c2 = rc.read();
+      if (c2 == null || c2 == c || !c2.compare(c) || c2.get_name() != "top_cfg")
+        `uvm_error("Test", "Configuration object was not restored")
+
+      $cast(rm, p2.get_by_name("env", "mode", uvm_resource#(mode_e)::get_type()));
+      if (rm.read() != FAST)
+        `uvm_error("Test", "Enumerated value was not restored")
+
+      $cast(rb, p2.get_by_name("env.agent", "width", uvm_resource#(uvm_bitstream_t)::get_type()));
+      if (rb.read() !== 'h1_0000_0000_0000_00FF)
+        `uvm_error("Test", $sformatf("Bit stream restored as 'h%0h", rb.read()))
+
+      $cast(rw, p2.get_by_name("env.sqr.main_phase", "default_sequence",
+                               uvm_resource#(uvm_object_wrapper)::get_type()));
+      if (rw.read() != cfg::get_type())
+        `uvm_error("Test", "Object wrapper was not restored")
+
+      $cast(ro, p2.get_by_name("env", "none", uvm_resource#(uvm_object)::get_type()));
+      if (ro.read() != null)
+        `uvm_error("Test", "Null object was not restored")
+
+      $cast(ri, p2.get_by_name("env.agent", "count", uvm_resource#(int)::get_type()));
+      if (ri.read() != 4)
+        `uvm_error("Test", $sformatf("count in env.agent is %0d instead of 4", ri.read()))
+   end
+
+   // Reload in a pool that already has a resource of the same name
+   p3.set(own);
+   void'(uvm_resource_snapshot::load("snapshot.bin", p3));
+   begin
+      uvm_resource_types::rsrc_q_t exp = new;
+      exp.push_back(rp.rtab["count"].get(0));   // config_db overrides
+      exp.push_back(rp.rtab["count"].get(1));
+      exp.push_back(own);
+      exp.push_back(rp.rtab["count"].get(2));
+      check_q("Merged name queue count", exp, p3.rtab["count"]);
+   end
+
+   begin
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      svr.summarize();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   end
+end
+
+endmodule
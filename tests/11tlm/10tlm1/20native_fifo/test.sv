@@ -0,0 +1,196 @@
+//---------------------------------------------------------------------- 
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide 
+// 
+//   Licensed under the Apache License, Version 2.0 (the 
+//   "License"); you may not use this file except in 
+//   compliance with the License.  You may obtain a copy of 
+//   the License at 
+// 
+//       http://www.apache.org/licenses/LICENSE-2.0 
+// 
+//   Unless required by applicable law or agreed to in 
+//   writing, software distributed under the License is 
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR 
+//   CONDITIONS OF ANY KIND, either express or implied.  See 
+//   the License for the specific language governing 
+//   permissions and limitations under the License. 
+//----------------------------------------------------------------------
+
+
+// This test checks uvm_tlm_native_fifo against the uvm_tlm_fifo semantics:
+// ordering, blocking on a full or empty FIFO, used/is_full/is_empty, the
+// batch operations and the analysis flavor, with single and multi-word
+// transactions. It then moves the same number of transactions through a
+// mailbox-based uvm_tlm_fifo one at a time and through a native FIFO in
+// batches, and reports the throughput of both.
+
+module test;
+  import uvm_pkg::*;
+  `include "uvm_macros.svh"
+
+  typedef struct packed {
+    bit [7:0]  kind;
+    bit [31:0] addr;
+    bit [31:0] data;
+  } item_t;
+
+  localparam int BENCH_ITEMS = 200000;
+  localparam int BENCH_BATCH = 1000;
+
+  class test extends uvm_test;
+    `uvm_component_utils(test)
+
+    bit failed;
+    uvm_tlm_native_fifo #(int) f;
+    uvm_tlm_native_fifo #(item_t) wf;
+    uvm_tlm_native_analysis_fifo #(int) af;
+    uvm_analysis_port #(int) ap;
+    uvm_tlm_fifo #(int) mf;
+    uvm_tlm_native_fifo #(int) nf;
+
+    function new(string name, uvm_component parent);
+      super.new(name, parent);
+    endfunction
+
+    function void build_phase(uvm_phase phase);
+      f = new("f", this, 4);
+      wf = new("wf", this, 0);
+      af = new("af", this);
+      ap = new("ap", this);
+      mf = new("mf", this, BENCH_BATCH);
+      nf = new("nf", this, BENCH_BATCH);
+    endfunction
+
+    function void connect_phase(uvm_phase phase);
+      ap.connect(af.analysis_export);
+    endfunction
+
+    function void check(bit ok, string msg);
+      if (!ok) begin
+        failed = 1;
+        `uvm_error("NATFIFO", msg)
+      end
+    endfunction
+
+    task run_phase(uvm_phase phase);
+      int v, q[];
+      time t;
+      item_t it, its[], got[];
+      phase.raise_objection(this);
+
+      // Status and non-blocking access
+      check(f.size() == 4 && f.is_empty() && !f.is_full() && f.used() == 0, "initial status");
+      check(!f.try_get(v) && !f.try_peek(v), "get from an empty fifo succeeded");
+      check(f.try_put_n({1,2,3,4,5,6}) == 4, "try_put_n did not stop at the bound");
+      check(f.is_full() && !f.can_put() && !f.try_put(7), "full fifo accepted a put");
+      check(f.try_peek(v) && v == 1 && f.used() == 4, "try_peek");
+      check(f.try_get(v) && v == 1 && f.used() == 3, "try_get");
+      check(f.try_get_n(q, 10) == 3 && q[0] == 2 && q[1] == 3 && q[2] == 4, "try_get_n");
+      check(f.is_empty() && f.can_put() && !f.can_get(), "status after draining");
+
+      // Blocking batches through a 4-entry fifo
+      fork
+        begin
+          int src[] = new[100];
+          foreach (src[i]) src[i] = i;
+          f.put_n(src);
+        end
+        begin
+          int n;
+          while (n < 100) begin
+            int k = (n % 7) + 1;
+            if (k > 100 - n) k = 100 - n;
+            #1;
+            f.get_n(q, k);
+            foreach (q[i])
+              check(q[i] == n + i, $sformatf("got %0d, expected %0d", q[i], n + i));
+            n += k;
+          end
+        end
+      join
+      check(f.is_empty(), "fifo not empty after blocking transfer");
+
+      // Single-item blocking get waits for a put
+      t = $time;
+      fork
+        begin
+          f.get(v);
+          check(v == 42 && $time == t + 100, $sformatf("blocking get returned %0d at %0t", v, $time));
+        end
+        #100 f.put(42);
+      join
+
+      // Multi-word transactions, unbounded, with wrap and growth
+      its = new[50];
+      foreach (its[i]) begin
+        its[i].kind = i;
+        its[i].addr = 32'h1000_0000 + i;
+        its[i].data = ~i;
+      end
+      for (int r = 0; r < 3; r++) begin
+        wf.put_n(its);
+        wf.get(it);
+        check(it == its[0], "multi-word get");
+        check(wf.try_get_n(got, 100) == 49, "multi-word try_get_n");
+        foreach (got[i])
+          check(got[i] == its[i+1], $sformatf("multi-word item %0d corrupted", i+1));
+      end
+
+      // Analysis flavor
+      ap.write(10);
+      af.write_n({11,12});
+      check(af.size() == 0 && af.used() == 3, "analysis fifo used");
+      check(af.try_get_n(q, 3) == 3 && q[0] == 10 && q[1] == 11 && q[2] == 12,
+            "analysis fifo contents");
+
+      benchmark();
+
+      phase.drop_objection(this);
+    endtask
+
+    task benchmark();
+      longint unsigned t0, t_mbx, t_nat;
+      int src[] = new[BENCH_BATCH];
+      int sum_mbx, sum_nat;
+
+      foreach (src[i]) src[i] = i;
+
+      t0 = uvm_wallclock_ns();
+      fork
+        for (int i = 0; i < BENCH_ITEMS; i++)
+          mf.put(i % BENCH_BATCH);
+        for (int i = 0; i < BENCH_ITEMS; i++) begin
+          int v;
+          mf.get(v);
+          sum_mbx += v;
+        end
+      join
+      t_mbx = uvm_wallclock_ns() - t0;
+
+      t0 = uvm_wallclock_ns();
+      fork
+        for (int i = 0; i < BENCH_ITEMS; i += BENCH_BATCH)
+          nf.put_n(src);
+        for (int i = 0; i < BENCH_ITEMS; i += BENCH_BATCH) begin
+          int q[];
+          nf.get_n(q, BENCH_BATCH);
+          foreach (q[j]) sum_nat += q[j];
+        end
+      join
+      t_nat = uvm_wallclock_ns() - t0;
+
+      check(sum_mbx == sum_nat, "benchmark transferred different data");
+      `uvm_info("NATFIFO", $sformatf("%0d items: mailbox fifo %0.3f ms, native fifo (batches of %0d) %0.3f ms",
+                                     BENCH_ITEMS, t_mbx / 1.0e6, BENCH_BATCH, t_nat / 1.0e6), UVM_NONE)
+    endtask
+
+    function void report_phase(uvm_phase phase);
+      if (failed) $display("** UVM TEST FAILED **");
+      else $display("** UVM TEST PASSED **");
+    endfunction
+  endclass
+
+  initial run_test("test");
+
+endmodule
@@ -0,0 +1,236 @@
+//---------------------------------------------------------------------- 
+//   Copyright 2011 Synopsys, Inc. 
+//   All Rights Reserved Worldwide 
+// 
+//   Licensed under the Apache License, Version 2.0 (the 
+//   "License"); you may not use this file except in 
+//   compliance with the License.  You may obtain a copy of 
+//   the License at 
+// 
+//       http://www.apache.org/licenses/LICENSE-2.0 
+// 
+//   Unless required by applicable law or agreed to in 
+//   writing, software distributed under the License is 
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR 
+//   CONDITIONS OF ANY KIND, either express or implied.  See 
+//   the License for the specific language governing 
+//   permissions and limitations under the License. 
+//----------------------------------------------------------------------
+
+// Checks the grant order of each arbitration mode, including priority
+// changes while requests are pending, locks and sequences that are not
+// always relevant.
+
+`include "uvm_macros.svh"
+program top;
+
+import uvm_pkg::*;
+
+
+class trans extends uvm_sequence_item;
+   `uvm_object_utils(trans)
+
+   function new(string name = "");
+      super.new(name);
+   endfunction
+endclass
+
+
+class pri_seq extends uvm_sequence#(trans);
+   `uvm_object_utils(pri_seq)
+
+   int n = 3;
+   bit do_lock;
+
+   function new(string name = "");
+      super.new(name);
+   endfunction
+   
+   task body();
+      if (do_lock) lock();
+      repeat (n) begin
+         req = trans::type_id::create("req");
+         start_item(req);
+         finish_item(req);
+      end
+      if (do_lock) unlock();
+   endtask
+endclass
+
+
+class rel_seq extends pri_seq;
+   `uvm_object_utils(rel_seq)
+
+   bit ready;
+
+   function new(string name = "");
+      super.new(name);
+   endfunction
+
+   function bit is_relevant();
+      return ready;
+   endfunction
+
+   task wait_for_relevant();
+      wait (ready);
+   endtask
+endclass
+
+
+class test extends uvm_test;
+
+   `uvm_component_utils(test)
+
+   uvm_sequencer#(trans) sqr;
+   uvm_seq_item_pull_port#(trans) seq_item_port;
+
+   bit    go;
+   string log[$];
+
+   function new(string name, uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   virtual function void build_phase(uvm_phase phase);
+      sqr = new("sqr", this);
+      seq_item_port = new("seq_item_port", this);
+   endfunction
+   
+   function void connect_phase(uvm_phase phase);
+      seq_item_port.connect(sqr.seq_item_export);
+   endfunction
+
+   task drive();
+      trans t;
+      forever begin
+         wait (go);
+         seq_item_port.get_next_item(t);
+         log.push_back(t.get_parent_sequence().get_name());
+         #1;
+         seq_item_port.item_done();
+         #1;
+      end
+   endtask
+
+   // Starts one sequence per entry of ~names~ at the given priority, with
+   // all requests queued before the driver pulls, and returns the grant order
+   task run_seqs(SEQ_ARB_TYPE mode, string names[], int pri[],
+                 output string order, input int bump = -1);
+      pri_seq seqs[];
+
+      sqr.set_arbitration(mode);
+      log.delete();
+      seqs = new[names.size()];
+      foreach (names[i]) begin
+         if (names[i] == "R")
+            seqs[i] = rel_seq::type_id::create(names[i]);
+         else
+            seqs[i] = pri_seq::type_id::create(names[i]);
+         seqs[i].do_lock = (names[i] == "L");
+      end
+
+      fork
+         begin
+            #5;
+            if (bump >= 0) seqs[bump].set_priority(1000);
+            go = 1;
+         end
+         begin
+            #20;
+            foreach (seqs[i]) begin
+               rel_seq r;
+               if ($cast(r, seqs[i])) r.ready = 1;
+            end
+         end
+      join_none
+
+      foreach (seqs[i]) begin
+         automatic int j = i;
+         fork
+            seqs[j].start(sqr, null, pri[j]);
+         join_none
+      end
+      wait fork;
+      go = 0;
+      #2;
+
+      order = "";
+      foreach (log[i]) order = {order, log[i]};
+   endtask
+
+   function void check(string what, string order, string exp);
+      if (order != exp)
+         `uvm_error("ARB", $sformatf("%s: grant order is \"%s\" instead of \"%s\"",
+                                     what, order, exp))
+   endfunction
+
+   function void check_counts(string what, string order, string names[]);
+      foreach (names[i]) begin
+         int n = 0;
+         for (int j = 0; j < order.len(); j++) if (order[j] == names[i][0]) n++;
+         if (n != 3)
+            `uvm_error("ARB", $sformatf("%s: sequence %s was granted %0d times instead of 3 in \"%s\"",
+                                        what, names[i], n, order))
+      end
+   endfunction
+
+   virtual task run_phase(uvm_phase phase);
+      string order;
+
+      phase.raise_objection(this);
+
+      fork
+         drive();
+      join_none
+
+      run_seqs(SEQ_ARB_FIFO, '{"a","b","c"}, '{100,300,200}, order);
+      check("FIFO", order, "abcabcabc");
+
+      run_seqs(SEQ_ARB_STRICT_FIFO, '{"a","b","c"}, '{100,300,200}, order);
+      check("STRICT_FIFO", order, "bbbcccaaa");
+
+      run_seqs(SEQ_ARB_STRICT_FIFO, '{"a","b","c"}, '{100,300,200}, order, 0);
+      check("STRICT_FIFO/set_priority", order, "aaabbbccc");
+
+      run_seqs(SEQ_ARB_STRICT_RANDOM, '{"a","b","c","d"}, '{100,300,200,300}, order);
+      check_counts("STRICT_RANDOM", order, '{"a","b","c","d"});
+      if (order.substr(6,8) != "ccc" || order.substr(9,11) != "aaa")
+         `uvm_error("ARB", $sformatf("STRICT_RANDOM: lower priorities granted early in \"%s\"", order))
+
+      run_seqs(SEQ_ARB_WEIGHTED, '{"a","b","c"}, '{100,300,200}, order);
+      check_counts("WEIGHTED", order, '{"a","b","c"});
+
+      run_seqs(SEQ_ARB_RANDOM, '{"a","b","c"}, '{100,300,200}, order);
+      check_counts("RANDOM", order, '{"a","b","c"});
+
+      run_seqs(SEQ_ARB_FIFO, '{"a","b","L"}, '{100,100,100}, order);
+      check("FIFO/lock", order, "LLLababab");
+
+      run_seqs(SEQ_ARB_STRICT_FIFO, '{"a","L","b"}, '{300,100,200}, order);
+      check("STRICT_FIFO/lock", order, "LLLaaabbb");
+
+      run_seqs(SEQ_ARB_FIFO, '{"R","a"}, '{100,100}, order);
+      check("FIFO/is_relevant", order, "aaaRRR");
+
+      run_seqs(SEQ_ARB_WEIGHTED, '{"R","a"}, '{100,100}, order);
+      check("WEIGHTED/is_relevant", order, "aaaRRR");
+
+      phase.drop_objection(this);
+   endtask
+
+   function void report_phase(uvm_phase phase);
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      if (svr.get_severity_count(UVM_FATAL) +
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   endfunction
+endclass
+
+
+initial run_test("test");
+
+endprogram
@@ -0,0 +1,141 @@
+//----------------------------------------------------------------------
+//   Copyright 2010-2011 Mentor Graphics Corporation
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// Checks objection batch mode: raises and drops within one time step are
+// coalesced, raised/dropped callbacks are only called when a total count
+// crosses zero, counts are exact when queried, and the phase still ends
+// once all objections are dropped, after the drain time.
+
+module test;
+
+  import uvm_pkg::*;
+  `include "uvm_macros.svh"
+
+  class counting_comp extends uvm_component;
+    int rcnt, dcnt, acnt;
+    function new (string name, uvm_component parent);
+      super.new(name, parent);
+    endfunction
+    virtual function void raised (uvm_objection objection, uvm_object source_obj,
+                                  string description, int count);
+      rcnt++;
+    endfunction
+    virtual function void dropped (uvm_objection objection, uvm_object source_obj,
+                                   string description, int count);
+      dcnt++;
+    endfunction
+    virtual task all_dropped (uvm_objection objection, uvm_object source_obj,
+                              string description, int count);
+      acnt++;
+    endtask
+  endclass
+
+  class leaf extends counting_comp;
+    `uvm_component_utils(leaf)
+    function new (string name, uvm_component parent);
+      super.new(name, parent);
+    endfunction
+  endclass
+
+  class test extends counting_comp;
+    `uvm_component_utils(test)
+
+    leaf l1, l2;
+    bit failed;
+
+    function new (string name, uvm_component parent);
+      super.new(name, parent);
+    endfunction
+
+    function void build_phase(uvm_phase phase);
+      l1 = new("l1", this);
+      l2 = new("l2", this);
+    endfunction
+
+    function void check(string what, int actual, int exp);
+      if (actual != exp) begin
+        `uvm_error("BATCH", $sformatf("%s is %0d instead of %0d", what, actual, exp))
+        failed = 1;
+      end
+    endfunction
+
+    task run_phase(uvm_phase phase);
+      uvm_objection obj = phase.get_objection();
+
+      void'(obj.batch_mode(1));
+      obj.set_drain_time(this, 10);
+
+      phase.raise_objection(l1);
+      check("count(l1) before flush", obj.get_objection_count(l1), 1);
+      check("total(test)", obj.get_objection_total(this), 1);
+      check("test raised", rcnt, 1);
+
+      // Per-item objections within one time step are never propagated
+      for (int i = 0; i < 1000; i++) begin
+        phase.raise_objection(l2);
+        phase.drop_objection(l2);
+        #1;
+      end
+      check("l2 raised", l2.rcnt, 0);
+      check("l2 dropped", l2.dcnt, 0);
+      check("test raised", rcnt, 1);
+      check("test dropped", dcnt, 0);
+
+      // Callbacks at zero crossings only
+      phase.raise_objection(l2, "", 2);
+      #1;
+      phase.raise_objection(l2);
+      #1;
+      check("total(l2)", obj.get_objection_total(l2), 3);
+      check("total(test)", obj.get_objection_total(this), 4);
+      check("l2 raised", l2.rcnt, 1);
+      check("test raised", rcnt, 1);
+
+      phase.drop_objection(l2);
+      #1;
+      check("l2 dropped", l2.dcnt, 0);
+      phase.drop_objection(l2, "", 2);
+      #1;
+      check("l2 dropped", l2.dcnt, 1);
+      check("total(test)", obj.get_objection_total(this), 1);
+      check("test dropped", dcnt, 0);
+
+      // An objection moving between objects does not empty the parent
+      phase.raise_objection(l2);
+      phase.drop_objection(l1);
+      #1;
+      check("test dropped", dcnt, 0);
+      check("count(l1)", obj.get_objection_count(l1), 0);
+
+      // The end of phase waits for the drain time of test
+      phase.drop_objection(l2);
+    endtask
+
+    function void report_phase(uvm_phase phase);
+      check("test dropped", dcnt, 1);
+      check("test all_dropped", acnt, 1);
+      check("end time", $time, 1015);
+      if (failed) $display("** UVM TEST FAILED **");
+      else $display("** UVM TEST PASSED **");
+    endfunction
+  endclass
+
+  initial run_test();
+
+endmodule
@@ -0,0 +1,162 @@
+//---------------------------------------------------------------------- 
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide 
+// 
+//   Licensed under the Apache License, Version 2.0 (the 
+//   "License"); you may not use this file except in 
+//   compliance with the License.  You may obtain a copy of 
+//   the License at 
+// 
+//       http://www.apache.org/licenses/LICENSE-2.0 
+// 
+//   Unless required by applicable law or agreed to in 
+//   writing, software distributed under the License is 
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR 
+//   CONDITIONS OF ANY KIND, either express or implied.  See 
+//   the License for the specific language governing 
+//   permissions and limitations under the License. 
+//----------------------------------------------------------------------
+
+// This test checks that, once the hierarchy is built, top-down,
+// bottom-up and task phases visit components in the same order as the
+// recursive traversal, that runtime phases only visit the components
+// of their domain, including after a domain change, and that the
+// phase profile records the time spent per component and phase,
+// including by a task phase that is killed at the end of the phase.
+
+module test;
+  import uvm_pkg::*;
+  `include "uvm_macros.svh"
+
+  bit failed = 0;
+  string visited[string][$];
+
+  class node extends uvm_component;
+    int fanout;
+    int depth;
+
+    function new(string name, uvm_component parent);
+      super.new(name,parent);
+    endfunction
+
+    function void build_phase(uvm_phase phase);
+      node n;
+      for (int i = 0; i < fanout; i++) begin
+        n = new($sformatf("n%0d", fanout-i), this);
+        if (depth > 1) begin
+          n.fanout = fanout;
+          n.depth = depth-1;
+        end
+      end
+    endfunction
+
+    function void connect_phase(uvm_phase phase);
+      visited["connect"].push_back(get_full_name());
+    endfunction
+
+    function void end_of_elaboration_phase(uvm_phase phase);
+      visited["end_of_elaboration"].push_back(get_full_name());
+    endfunction
+
+    task main_phase(uvm_phase phase);
+      visited[{"main:", get_domain().get_name()}].push_back(get_full_name());
+      phase.raise_objection(this);
+      #10;
+      phase.drop_objection(this);
+    endtask
+
+    task run_phase(uvm_phase phase);
+      visited["run"].push_back(get_full_name());
+    endtask
+  endclass
+
+  class test extends node;
+    `uvm_component_utils(test)
+    function new(string name, uvm_component parent);
+      super.new(name,parent);
+      fanout = 3;
+      depth = 3;
+    endfunction
+
+    function void end_of_elaboration_phase(uvm_phase phase);
+      uvm_domain dom = new("other");
+      uvm_component c = uvm_top.find("uvm_test_top.n2");
+      super.end_of_elaboration_phase(phase);
+      c.set_domain(dom);
+    endfunction
+
+    // Killed at the end of the phase, never returns
+    task run_phase(uvm_phase phase);
+      super.run_phase(phase);
+      forever #1;
+    endtask
+
+    // Expected visiting order of the recursive traversals
+    function void expect_order(uvm_component comp, bit topdown, string dom,
+                               ref string q[$]);
+      string name;
+      bit member = (dom == "" || comp.get_domain().get_name() == dom);
+      if (topdown && member) q.push_back(comp.get_full_name());
+      if (comp.get_first_child(name))
+        do
+          expect_order(comp.get_child(name), topdown, dom, q);
+        while (comp.get_next_child(name));
+      if (!topdown && member) q.push_back(comp.get_full_name());
+    endfunction
+
+    function void check(string phase, bit topdown, string dom="");
+      string exp[$];
+      expect_order(this, topdown, dom, exp);
+      if (visited[phase] != exp) begin
+        failed = 1;
+        `uvm_error("ORDER", $sformatf("%s visited %0d components, expected %0d, or in the wrong order",
+                                      phase, visited[phase].size(), exp.size()))
+      end
+    endfunction
+
+    function void report_phase(uvm_phase phase);
+      longint unsigned wall;
+      time sim;
+
+      check("connect", 0);
+      check("end_of_elaboration", 1);
+      check("run", 0);
+      check("main:uvm", 0, "uvm");
+      check("main:other", 0, "other");
+      if (visited["main:other"].size() != 13) begin
+        failed = 1;
+        `uvm_error("DOMAIN", $sformatf("%0d components ran main in domain 'other', expected 13",
+                                       visited["main:other"].size()))
+      end
+
+      if (!uvm_top.get_phase_profile(this, "main", wall, sim) || sim != 10) begin
+        failed = 1;
+        `uvm_error("PROFILE", $sformatf("main phase of %s profiled as %0t, expected 10",
+                                        get_full_name(), sim))
+      end
+      if (!uvm_top.get_phase_profile(this, "run", wall, sim) || sim < 10) begin
+        failed = 1;
+        `uvm_error("PROFILE", $sformatf("killed run phase of %s profiled as %0t, expected at least 10",
+                                        get_full_name(), sim))
+      end
+      if (!uvm_top.get_phase_profile(uvm_top.find("uvm_test_top.n1.n3"), "build", wall, sim) ||
+          sim != 0) begin
+        failed = 1;
+        `uvm_error("PROFILE", "build phase of uvm_test_top.n1.n3 not profiled")
+      end
+      if (uvm_top.get_phase_profile(this, "no_such_phase", wall, sim)) begin
+        failed = 1;
+        `uvm_error("PROFILE", "profile found for a phase that does not exist")
+      end
+
+      if(failed) $display("*** UVM TEST FAILED ***");
+      else $display("*** UVM TEST PASSED ***");
+    endfunction
+  endclass
+
+  initial begin
+    uvm_top.enable_phase_profile = 1;
+    run_test();
+  end
+
+endmodule
@@ -0,0 +1,235 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// Predicting a register of a locked model with its compiled predict plan
+// gives the same mirror as predicting it field by field. Registers "B"
+// have a callback on each field, which forces the field-by-field path.
+
+`include "uvm_macros.svh"
+program top;
+
+import uvm_pkg::*;
+
+class nop_cbs extends uvm_reg_cbs;
+   int n_calls;
+
+   function new(string name = "nop_cbs");
+      super.new(name);
+   endfunction
+
+   virtual function void post_predict(input uvm_reg_field  fld,
+                                      input uvm_reg_data_t previous,
+                                      inout uvm_reg_data_t value,
+                                      input uvm_predict_e  kind,
+                                      input uvm_path_e     path,
+                                      input uvm_reg_map    map);
+      n_calls++;
+   endfunction
+endclass
+
+
+// One 2-bit field per access policy, except W1 and WO1
+class all_reg extends uvm_reg;
+   static string policies[] = '{"RO", "RW", "RC", "RS", "WRC", "WRS",
+                                "WC", "WS", "WSRC", "WCRS", "W1C", "W1S",
+                                "W1T", "W0C", "W0S", "W0T", "W1SRC", "W1CRS",
+                                "W0SRC", "W0CRS", "WO", "WOC", "WOS"};
+   uvm_reg_field f[];
+
+   `uvm_object_utils(all_reg)
+
+   function new(string name = "all_reg");
+      super.new(name, 64, UVM_NO_COVERAGE);
+   endfunction
+
+   virtual function void build();
+      f = new [policies.size()];
+      foreach (f[i]) begin
+         f[i] = uvm_reg_field::type_id::create(policies[i]);
+         f[i].configure(this, 2, 2*i, policies[i], 0, i % 4, 1, 0, 1);
+      end
+   endfunction
+endclass
+
+
+// W1 and WO1 writes depend on whether the field was written before
+class w1_reg extends uvm_reg;
+   uvm_reg_field A;
+   uvm_reg_field B;
+   uvm_reg_field C;
+
+   `uvm_object_utils(w1_reg)
+
+   function new(string name = "w1_reg");
+      super.new(name, 16, UVM_NO_COVERAGE);
+   endfunction
+
+   virtual function void build();
+      A = uvm_reg_field::type_id::create("A");
+      B = uvm_reg_field::type_id::create("B");
+      C = uvm_reg_field::type_id::create("C");
+      A.configure(this, 4, 0, "W1", 0, 0, 1, 0, 1);
+      B.configure(this, 4, 4, "WO1", 0, 0, 1, 0, 1);
+      C.configure(this, 8, 8, "RW", 0, 0, 1, 0, 1);
+   endfunction
+endclass
+
+
+class blk extends uvm_reg_block;
+   all_reg A, B;
+   w1_reg  W1A, W1B;
+
+   `uvm_object_utils(blk)
+
+   function new(string name = "blk");
+      super.new(name, UVM_NO_COVERAGE);
+   endfunction
+
+   function void build();
+      default_map = create_map("", 0, 8, UVM_LITTLE_ENDIAN);
+
+      A = all_reg::type_id::create("A");
+      A.configure(this);
+      A.build();
+      default_map.add_reg(A, 'h00);
+
+      B = all_reg::type_id::create("B");
+      B.configure(this);
+      B.build();
+      default_map.add_reg(B, 'h08);
+
+      W1A = w1_reg::type_id::create("W1A");
+      W1A.configure(this);
+      W1A.build();
+      default_map.add_reg(W1A, 'h10);
+
+      W1B = w1_reg::type_id::create("W1B");
+      W1B.configure(this);
+      W1B.build();
+      default_map.add_reg(W1B, 'h18);
+   endfunction
+endclass
+
+
+initial
+begin
+   blk            model;
+   nop_cbs        cbs = new;
+   uvm_reg_field  fa[$], fb[$];
+   int            n_errs;
+   uvm_predict_e  kinds[3] = '{UVM_PREDICT_DIRECT, UVM_PREDICT_WRITE,
+                               UVM_PREDICT_READ};
+   uvm_path_e     paths[3] = '{UVM_FRONTDOOR, UVM_PREDICT, UVM_BACKDOOR};
+
+   model = new("model");
+   model.build();
+   model.lock_model();
+
+   model.W1B.get_fields(fb);
+   foreach (fb[i])
+     uvm_reg_field_cb::add(fb[i], cbs);
+   fb.delete();
+   model.B.get_fields(fb);
+   foreach (fb[i])
+     uvm_reg_field_cb::add(fb[i], cbs);
+
+   model.A.get_fields(fa);
+
+   // Random predictions of every kind, through every path,
+   // with random byte enables
+   for (int n = 0; n < 2000; n++) begin
+      uvm_reg_data_t    val;
+      uvm_reg_byte_en_t be;
+      uvm_predict_e     kind = kinds[$urandom_range(2)];
+      uvm_path_e        path = paths[$urandom_range(2)];
+      uvm_reg_map       map  = ($urandom_range(1)) ? model.default_map : null;
+
+      val = {$urandom, $urandom};
+      be  = ($urandom_range(3) == 0) ? $urandom : -1;
+
+      void'(model.A.predict(val, be, kind, path, map));
+      void'(model.B.predict(val, be, kind, path, map));
+      void'(model.W1A.predict(val, be, kind, path, map));
+      void'(model.W1B.predict(val, be, kind, path, map));
+
+      if (model.A.get_mirrored_value() != model.B.get_mirrored_value() ||
+          model.A.get() != model.B.get()) begin
+         `uvm_error("Test", $sformatf("%s %s be='h%h value='h%h: mirror 'h%h, expected 'h%h",
+                                      kind.name(), path.name(), be, val,
+                                      model.A.get_mirrored_value(),
+                                      model.B.get_mirrored_value()))
+         n_errs++;
+      end
+
+      if (model.W1A.get_mirrored_value() != model.W1B.get_mirrored_value()) begin
+         `uvm_error("Test", $sformatf("W1 %s %s be='h%h value='h%h: mirror 'h%h, expected 'h%h",
+                                      kind.name(), path.name(), be, val,
+                                      model.W1A.get_mirrored_value(),
+                                      model.W1B.get_mirrored_value()))
+         n_errs++;
+      end
+
+      // Re-align the registers after a mismatch
+      if (n_errs > 0 && n_errs < 10) begin
+         void'(model.A.predict(model.B.get_mirrored_value()));
+         void'(model.W1A.predict(model.W1B.get_mirrored_value()));
+      end
+      if (n_errs >= 10) break;
+   end
+
+   if (cbs.n_calls == 0)
+     `uvm_error("Test", "Field callbacks of register B were never called")
+
+   // A policy change after the plan was compiled is taken into account
+   void'(fa[1].set_access("RO"));
+   void'(fb[1].set_access("RO"));
+   void'(model.A.predict(0, -1, UVM_PREDICT_DIRECT));
+   void'(model.A.predict('hF << 2, -1, UVM_PREDICT_WRITE, UVM_PREDICT,
+                         model.default_map));
+   if (fa[1].get_mirrored_value() != 0)
+     `uvm_error("Test", $sformatf("RO field was predicted as 'h%h after a write",
+                                  fa[1].get_mirrored_value()))
+
+   // A callback added after the plan was compiled is called
+   begin
+      nop_cbs late = new("late");
+      uvm_reg_field_cb::add(fa[2], late);
+      void'(model.A.predict(0, -1, UVM_PREDICT_WRITE, UVM_PREDICT,
+                            model.default_map));
+      if (late.n_calls != 1)
+        `uvm_error("Test", $sformatf("Late callback called %0d times instead of once",
+                                     late.n_calls))
+      uvm_reg_field_cb::delete(fa[2], late);
+   end
+
+   begin
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      svr.summarize();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   end
+end
+
+endprogram
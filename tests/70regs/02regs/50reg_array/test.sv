@@ -0,0 +1,378 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// Elements of a uvm_reg_array are written, read, predicted, updated,
+// mirrored and reset without creating a uvm_reg for each of them, and
+// keep their value when a uvm_reg is created for them on demand. The
+// predictor publishes the array and element index for the former, and
+// the register for the latter.
+
+`include "uvm_macros.svh"
+module top;
+
+import uvm_pkg::*;
+
+class bus_rw extends uvm_sequence_item;
+   bit        read;
+   bit [31:0] addr;
+   bit [31:0] data;
+
+   `uvm_object_utils(bus_rw)
+
+   function new(string name = "bus_rw");
+      super.new(name);
+   endfunction
+
+   function string convert2string();
+      return $sformatf("%s addr=%0h data=%0h", (read) ? "READ" : "WRITE",
+                       addr, data);
+   endfunction
+endclass
+
+
+class bus_sequencer extends uvm_sequencer #(bus_rw);
+   `uvm_component_utils(bus_sequencer)
+
+   function new(string name, uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+endclass
+
+
+// Memory-backed driver, 4-byte bus, byte addressing
+class bus_driver extends uvm_driver #(bus_rw);
+   `uvm_component_utils(bus_driver)
+
+   uvm_analysis_port #(bus_rw) ap;
+   bit [31:0] mem[bit [31:0]];
+   int        n_trans;
+
+   function new(string name, uvm_component parent = null);
+      super.new(name, parent);
+      ap = new("ap", this);
+   endfunction
+
+   task run_phase(uvm_phase phase);
+      forever begin
+         bus_rw rw;
+         seq_item_port.get_next_item(rw);
+         n_trans++;
+         if (rw.read)
+           rw.data = mem.exists(rw.addr) ? mem[rw.addr] : 0;
+         else
+           mem[rw.addr] = rw.data;
+         #10;
+         ap.write(rw);
+         seq_item_port.item_done();
+      end
+   endtask
+endclass
+
+
+class bus_adapter extends uvm_reg_adapter;
+   `uvm_object_utils(bus_adapter)
+
+   function new(string name = "bus_adapter");
+      super.new(name);
+   endfunction
+
+   virtual function uvm_sequence_item reg2bus(const ref uvm_reg_bus_op rw);
+      bus_rw bus = bus_rw::type_id::create("rw");
+      bus.read = (rw.kind == UVM_READ);
+      bus.addr = rw.addr;
+      bus.data = rw.data;
+      return bus;
+   endfunction
+
+   virtual function void bus2reg(uvm_sequence_item bus_item,
+                                 ref uvm_reg_bus_op rw);
+      bus_rw bus;
+      if (!$cast(bus, bus_item)) begin
+         `uvm_fatal("NOT_BUS_TYPE", "Provided bus_item is not of the correct type")
+         return;
+      end
+      rw.kind   = bus.read ? UVM_READ : UVM_WRITE;
+      rw.addr   = bus.addr;
+      rw.data   = bus.data;
+      rw.status = UVM_IS_OK;
+   endfunction
+endclass
+
+
+class descr_reg extends uvm_reg;
+   rand uvm_reg_field A;
+   rand uvm_reg_field S;
+
+   `uvm_object_utils(descr_reg)
+
+   function new(string name = "descr_reg");
+      super.new(name, 32, UVM_NO_COVERAGE);
+   endfunction
+
+   virtual function void build();
+      A = uvm_reg_field::type_id::create("A");
+      A.configure(this, 16,  0, "RW",  0, 'h1234, 1, 1, 1);
+      S = uvm_reg_field::type_id::create("S");
+      S.configure(this,  8, 16, "W1C", 0, 'h00,   1, 1, 1);
+   endfunction
+endclass
+
+
+class descr_array extends uvm_reg_array;
+   `uvm_object_utils(descr_array)
+
+   function new(string name = "descr_array", int unsigned size = 1);
+      super.new(name, size);
+   endfunction
+
+   virtual function uvm_reg create_reg(string name);
+      descr_reg rg = descr_reg::type_id::create(name);
+      rg.build();
+      return rg;
+   endfunction
+endclass
+
+
+class blk extends uvm_reg_block;
+   descr_reg   R;
+   descr_array ARR;
+   descr_array EVN, ODD;
+
+   `uvm_object_utils(blk)
+
+   function new(string name = "blk");
+      super.new(name, UVM_NO_COVERAGE);
+   endfunction
+
+   virtual function void build();
+      default_map = create_map("", 0, 4, UVM_LITTLE_ENDIAN);
+      R = descr_reg::type_id::create("R");
+      R.configure(this);
+      R.build();
+      default_map.add_reg(R, 'h0);
+      ARR = new("ARR", 1024);
+      ARR.configure(this);
+      default_map.add_reg_array(ARR, 'h1000);
+      // Interleaved arrays, with overlapping address ranges
+      EVN = new("EVN", 4);
+      EVN.configure(this);
+      default_map.add_reg_array(EVN, 'h2000, "RW", 8);
+      ODD = new("ODD", 4);
+      ODD.configure(this);
+      default_map.add_reg_array(ODD, 'h2004, "RW", 8);
+   endfunction
+endclass
+
+
+// Keeps the last item published by the predictor
+class reg_item_sub extends uvm_subscriber #(uvm_reg_item);
+   uvm_reg_item last;
+
+   `uvm_component_utils(reg_item_sub)
+
+   function new(string name, uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   function void write(uvm_reg_item t);
+      last = t;
+   endfunction
+endclass
+
+
+class test extends uvm_test;
+   blk                       model;
+   bus_sequencer             sqr;
+   bus_driver                drv;
+   uvm_reg_predictor#(bus_rw) predictor;
+   reg_item_sub              sub;
+
+   `uvm_component_utils(test)
+
+   function new(string name = "test", uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   virtual function void build_phase(uvm_phase phase);
+      model = blk::type_id::create("model");
+      model.build();
+      model.lock_model();
+      sqr = bus_sequencer::type_id::create("sqr", this);
+      drv = bus_driver::type_id::create("drv", this);
+      predictor = uvm_reg_predictor#(bus_rw)::type_id::create("predictor", this);
+      sub = reg_item_sub::type_id::create("sub", this);
+   endfunction
+
+   virtual function void connect_phase(uvm_phase phase);
+      bus_adapter adapter = new;
+      drv.seq_item_port.connect(sqr.seq_item_export);
+      model.default_map.set_sequencer(sqr, adapter);
+      predictor.map = model.default_map;
+      predictor.adapter = adapter;
+      drv.ap.connect(predictor.bus_in);
+      predictor.reg_ap.connect(sub.analysis_export);
+   endfunction
+
+   // Checks the last item published by the predictor
+   function void check_item(uvm_object elem, int unsigned idx, uvm_access_e kind,
+                            uvm_reg_data_t value, string what);
+      uvm_reg_item item = sub.last;
+      if (item == null || item.element_kind != UVM_REG || item.element != elem ||
+          (elem == model.ARR && item.offset != idx) ||
+          item.kind != kind || item.value[0] != value)
+        `uvm_error("Test", $sformatf("Predictor published %s %s",
+                                     (item == null) ? "nothing" : item.convert2string(), what))
+   endfunction
+
+   function void check_mirror(int unsigned idx, uvm_reg_data_t exp, string what);
+      if (model.ARR.get_mirrored_value(idx) != exp)
+        `uvm_error("Test", $sformatf("ARR[%0d] mirror is 'h%0h instead of 'h%0h %s",
+                                     idx, model.ARR.get_mirrored_value(idx), exp, what))
+   endfunction
+
+   function void check_materialized(int unsigned exp, string what);
+      if (model.ARR.get_n_materialized() != exp)
+        `uvm_error("Test", $sformatf("%0d elements materialized instead of %0d %s",
+                                     model.ARR.get_n_materialized(), exp, what))
+   endfunction
+
+   virtual task run_phase(uvm_phase phase);
+      uvm_status_e   status;
+      uvm_reg_data_t value;
+      uvm_reg        rg5, rg12;
+      uvm_reg        regs[$];
+
+      phase.raise_objection(this);
+
+      check_mirror(7, 'h1234, "after the HARD reset");
+
+      // Offset lookups through the sorted array ranges
+      begin
+         uvm_reg_addr_t offsets[5] = '{'h1014, 'h2008, 'h200C, 'h0FFC, 'h2020};
+         uvm_reg_array  exp_arr[5] = '{model.ARR, model.EVN, model.ODD, null, null};
+         int unsigned   exp_idx[5] = '{5, 1, 1, 0, 0};
+         foreach (offsets[i]) begin
+            uvm_reg_array arr;
+            int unsigned  idx;
+            arr = model.default_map.get_reg_array_by_offset(offsets[i], idx);
+            if (arr != exp_arr[i] || idx != exp_idx[i])
+              `uvm_error("Test", $sformatf("Offset 'h%0h is element %0d of %s",
+                                           offsets[i], idx,
+                                           (arr == null) ? "no array" : arr.get_name()))
+         end
+      end
+
+      // Registers are found without a register array lookup
+      if (model.default_map.m_get_reg_by_offset('h0, 1) != model.R)
+        `uvm_error("Test", "R was not found in the offset table")
+      if (model.default_map.m_get_reg_by_offset('h1014, 1) != null)
+        `uvm_error("Test", "A register array element is in the offset table")
+
+      // Front-door accesses, predicted by the explicit predictor
+      model.ARR.write(status, 5, 'hABCD);
+      if (drv.mem['h1014] != 'hABCD)
+        `uvm_error("Test", "ARR[5] was not written in the DUT")
+      check_mirror(5, 'hABCD, "after write()");
+      check_item(model.ARR, 5, UVM_WRITE, 'hABCD, "for the write of ARR[5]");
+
+      drv.mem['h1024] = 'h00FF_5678;
+      model.ARR.read(status, 9, value);
+      if (value != 'h00FF_5678)
+        `uvm_error("Test", $sformatf("ARR[9] read 'h%0h", value))
+      check_mirror(9, 'h00FF_5678, "after read()");
+      check_item(model.ARR, 9, UVM_READ, 'h00FF_5678, "for the read of ARR[9]");
+
+      // W1C bits written with 1 are cleared
+      model.ARR.write(status, 9, 'h00F0_0000);
+      check_mirror(9, 'h000F_0000, "after clearing W1C bits");
+
+      model.ARR.mirror(status, 9);
+      check_mirror(9, 'h00F0_0000, "after mirror()");
+      check_materialized(0, "by front-door accesses");
+
+      model.get_registers(regs);
+      if (regs.size() != 1)
+        `uvm_error("Test", $sformatf("Block has %0d registers instead of 1", regs.size()))
+
+      // Materialized elements keep their value
+      rg5 = model.default_map.get_reg_by_offset('h1014);
+      if (rg5 == null || rg5.get_name() != "ARR[5]")
+        `uvm_error("Test", "ARR[5] was not found by offset")
+      else if (rg5.get_mirrored_value() != 'hABCD)
+        `uvm_error("Test", $sformatf("Materialized ARR[5] is 'h%0h", rg5.get_mirrored_value()))
+
+      rg12 = model.get_reg_by_name("ARR[12]");
+      if (rg12 == null || rg12.get_address() != 'h1030)
+        `uvm_error("Test", "ARR[12] was not found by name at 'h1030")
+      if (model.get_reg_by_name("ARR[5]") != rg5)
+        `uvm_error("Test", "ARR[5] was materialized twice")
+      check_materialized(2, "by name and offset lookups");
+
+      // Materialized elements are accessed as registers
+      model.ARR.write(status, 12, 'h4444);
+      if (rg12.get_mirrored_value() != 'h4444)
+        `uvm_error("Test", "Write to ARR[12] did not update its register")
+      check_item(rg12, 12, UVM_WRITE, 'h4444, "for the write of the materialized ARR[12]");
+
+      // Block-level update, reset and mirror cover all elements
+      model.ARR.set(100, 'h55);
+      rg5.set('h77);
+      if (!model.needs_update())
+        `uvm_error("Test", "Block does not need an update")
+      drv.n_trans = 0;
+      model.update(status);
+      if (drv.n_trans != 2 || drv.mem['h1190] != 'h55 || drv.mem['h1014] != 'h77)
+        `uvm_error("Test", $sformatf("update() used %0d accesses", drv.n_trans))
+      if (model.needs_update())
+        `uvm_error("Test", "Block needs an update after update()")
+
+      model.reset();
+      check_mirror(100, 'h1234, "after reset()");
+      if (rg5.get_mirrored_value() != 'h1234)
+        `uvm_error("Test", "Materialized ARR[5] was not reset")
+
+      drv.mem['h1320] = 'h4321;
+      model.mirror(status);
+      if (status != UVM_IS_OK)
+        `uvm_error("Test", $sformatf("mirror() returned %s", status.name()))
+      check_mirror(200, 'h4321, "after the block mirror()");
+      if (rg5.get_mirrored_value() != 'h77)
+        `uvm_error("Test", "Materialized ARR[5] was not mirrored")
+
+      check_materialized(2, "at the end of the test");
+
+      phase.drop_objection(this);
+   endtask
+
+   virtual function void report_phase(uvm_phase phase);
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   endfunction
+endclass
+
+
+initial run_test("test");
+
+endmodule
@@ -0,0 +1,206 @@
+//---------------------------------------------------------------------- 
+//   Copyright 2010 Synopsys, Inc. 
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide 
+// 
+//   Licensed under the Apache License, Version 2.0 (the 
+//   "License"); you may not use this file except in 
+//   compliance with the License.  You may obtain a copy of 
+//   the License at 
+// 
+//       http://www.apache.org/licenses/LICENSE-2.0 
+// 
+//   Unless required by applicable law or agreed to in 
+//   writing, software distributed under the License is 
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR 
+//   CONDITIONS OF ANY KIND, either express or implied.  See 
+//   the License for the specific language governing 
+//   permissions and limitations under the License. 
+//----------------------------------------------------------------------
+
+// get_*_by_name: a locked block answers from its name index with the
+// same objects the search of an unlocked block finds.
+
+`include "uvm_macros.svh"
+program top;
+
+import uvm_pkg::*;
+
+class my_catcher extends uvm_report_catcher;
+   static int n_dupl = 0;
+   static int n_miss = 0;
+   virtual function action_e catch();
+      if (get_severity() == UVM_WARNING && get_id() == "RegModel") begin
+         string msg = get_message();
+         for (int i = 0; i + 13 <= msg.len(); i++)
+           if (msg.substr(i, i+12) == "more than one") begin
+              n_dupl++;
+              return CAUGHT;
+           end
+         if (msg.substr(0, 16) == "Unable to locate ") begin
+            n_miss++;
+            return CAUGHT;
+         end
+      end
+      return THROW;
+   endfunction
+endclass
+
+
+class reg1 extends uvm_reg;
+   rand uvm_reg_field EN;
+   rand uvm_reg_field DATA;
+
+   `uvm_object_utils(reg1)
+
+   function new(string name = "reg1");
+      super.new(name, 16, UVM_NO_COVERAGE);
+   endfunction
+
+   virtual function void build();
+      EN   = uvm_reg_field::type_id::create("EN");
+      DATA = uvm_reg_field::type_id::create("DATA");
+      EN.configure(this, 1, 0, "RW", 0, 0, 1, 1, 0);
+      DATA.configure(this, 8, 8, "RW", 0, 0, 1, 1, 0);
+   endfunction
+endclass
+
+
+class blk1 extends uvm_reg_block;
+   rand reg1 CTRL;
+   rand reg1 LOCAL;
+
+   `uvm_object_utils(blk1)
+   
+   function new(string name = "blk1");
+      super.new(name, UVM_NO_COVERAGE);
+   endfunction
+
+   function void build();
+      default_map = create_map("", 0, 2, UVM_BIG_ENDIAN);
+      CTRL = reg1::type_id::create("CTRL");
+      CTRL.configure(this);
+      CTRL.build();
+      default_map.add_reg(CTRL, 0);
+      LOCAL = reg1::type_id::create({get_name(), "_LOCAL"});
+      LOCAL.configure(this);
+      LOCAL.build();
+      default_map.add_reg(LOCAL, 2);
+   endfunction
+endclass
+
+
+class blk2 extends uvm_reg_block;
+   rand reg1 TOP;
+   rand reg1 DUP1;
+   rand reg1 DUP2;
+   blk1 s1;
+   blk1 s2;
+   uvm_mem M;
+
+   `uvm_object_utils(blk2)
+
+   function new(string name = "blk2");
+      super.new(name, UVM_NO_COVERAGE);
+   endfunction
+
+   function void build();
+      default_map = create_map("", 0, 2, UVM_BIG_ENDIAN);
+
+      TOP = reg1::type_id::create("TOP");
+      TOP.configure(this);
+      TOP.build();
+      default_map.add_reg(TOP, 0);
+
+      // Two registers of this block with the same name
+      DUP1 = reg1::type_id::create("DUP");
+      DUP1.configure(this);
+      DUP1.build();
+      default_map.add_reg(DUP1, 2);
+      DUP2 = reg1::type_id::create("DUP");
+      DUP2.configure(this);
+      DUP2.build();
+      default_map.add_reg(DUP2, 4);
+
+      M = new("M", 16, 16);
+      M.configure(this);
+      default_map.add_mem(M, 'h100);
+
+      s1 = blk1::type_id::create("s1");
+      s1.configure(this);
+      s1.build();
+      default_map.add_submap(s1.default_map, 'h1000);
+
+      s2 = blk1::type_id::create("s2");
+      s2.configure(this);
+      s2.build();
+      default_map.add_submap(s2.default_map, 'h2000);
+   endfunction
+endclass
+
+
+initial
+begin
+   my_catcher c;
+   blk2 b;
+   string names[$] = '{"TOP", "DUP", "CTRL", "s1_LOCAL", "s2_LOCAL", "EN", "DATA",
+                       "M", "s1", "s2", "blk2", "nothing"};
+   uvm_reg_block exp_blk[string];
+   uvm_reg       exp_reg[string];
+   uvm_reg_field exp_fld[string];
+   uvm_mem       exp_mem[string];
+
+   c = new;
+   uvm_report_cb::add(null, c);
+
+   b = blk2::type_id::create("blk2");
+   b.build();
+
+   // Unlocked: searched
+   foreach (names[i]) begin
+      exp_blk[names[i]] = b.get_block_by_name(names[i]);
+      exp_reg[names[i]] = b.get_reg_by_name(names[i]);
+      exp_fld[names[i]] = b.get_field_by_name(names[i]);
+      exp_mem[names[i]] = b.get_mem_by_name(names[i]);
+   end
+   if (exp_reg["TOP"] != b.TOP || exp_reg["s2_LOCAL"] != b.s2.LOCAL ||
+       exp_mem["M"] != b.M || exp_blk["s1"] != b.s1 || exp_fld["nothing"] != null)
+      `uvm_error("Test", "Unlocked lookups returned unexpected objects")
+
+   b.lock_model();
+
+   // Locked: indexed
+   foreach (names[i]) begin
+      if (b.get_block_by_name(names[i]) != exp_blk[names[i]])
+         `uvm_error("Test", {"get_block_by_name differs for ", names[i]})
+      if (b.get_reg_by_name(names[i]) != exp_reg[names[i]])
+         `uvm_error("Test", {"get_reg_by_name differs for ", names[i]})
+      if (b.get_field_by_name(names[i]) != exp_fld[names[i]])
+         `uvm_error("Test", {"get_field_by_name differs for ", names[i]})
+      if (b.get_mem_by_name(names[i]) != exp_mem[names[i]])
+         `uvm_error("Test", {"get_mem_by_name differs for ", names[i]})
+   end
+   if (b.s1.get_reg_by_name("CTRL") != b.s1.CTRL ||
+       b.s2.get_field_by_name("EN") != b.s2.CTRL.EN && b.s2.get_field_by_name("EN") != b.s2.LOCAL.EN)
+      `uvm_error("Test", "Sub-block lookups returned unexpected objects")
+
+   if (my_catcher::n_dupl != 1)
+      `uvm_error("Test", $sformatf("%0d duplicate name warnings instead of 1", my_catcher::n_dupl))
+   if (my_catcher::n_miss == 0)
+      `uvm_error("Test", "No warnings for missing names")
+
+   begin
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      svr.summarize();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   end
+end
+
+endprogram
@@ -0,0 +1,377 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// uvm_reg_block::update() and mirror() coalesce the accesses to registers
+// and register array elements at adjacent addresses into bursts when the
+// adapter supports bursts, and the explicit predictor updates the mirror
+// from the bursts.
+
+`include "uvm_macros.svh"
+module top;
+
+import uvm_pkg::*;
+
+class bus_rw extends uvm_sequence_item;
+   bit        read;
+   bit [31:0] addr;
+   bit [31:0] data[$];
+
+   `uvm_object_utils(bus_rw)
+
+   function new(string name = "bus_rw");
+      super.new(name);
+   endfunction
+
+   function string convert2string();
+      return $sformatf("%s addr=%0h len=%0d", (read) ? "READ" : "WRITE",
+                       addr, data.size());
+   endfunction
+endclass
+
+
+class bus_sequencer extends uvm_sequencer #(bus_rw);
+   `uvm_component_utils(bus_sequencer)
+
+   function new(string name, uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+endclass
+
+
+// Memory-backed driver, 4-byte bus, byte addressing
+class bus_driver extends uvm_driver #(bus_rw);
+   `uvm_component_utils(bus_driver)
+
+   uvm_analysis_port #(bus_rw) ap;
+   bit [31:0] mem[bit [31:0]];
+   int        n_trans;
+   int        lengths[$];
+
+   function new(string name, uvm_component parent = null);
+      super.new(name, parent);
+      ap = new("ap", this);
+   endfunction
+
+   task run_phase(uvm_phase phase);
+      forever begin
+         bus_rw rw;
+         seq_item_port.get_next_item(rw);
+         n_trans++;
+         lengths.push_back(rw.data.size());
+         foreach (rw.data[i]) begin
+            if (rw.read)
+              rw.data[i] = mem.exists(rw.addr + 4*i) ? mem[rw.addr + 4*i] : 0;
+            else
+              mem[rw.addr + 4*i] = rw.data[i];
+         end
+         #10;
+         ap.write(rw);
+         seq_item_port.item_done();
+      end
+   endtask
+endclass
+
+
+class bus_adapter extends uvm_reg_adapter;
+   `uvm_object_utils(bus_adapter)
+
+   function new(string name = "bus_adapter");
+      super.new(name);
+      supports_bursts = 1;
+      max_burst_length = 4;
+   endfunction
+
+   virtual function uvm_sequence_item reg2bus(const ref uvm_reg_bus_op rw);
+      bus_rw bus = bus_rw::type_id::create("rw");
+      bus.read = (rw.kind == UVM_READ);
+      bus.addr = rw.addr;
+      bus.data.push_back(rw.data);
+      return bus;
+   endfunction
+
+   virtual function void bus2reg(uvm_sequence_item bus_item,
+                                 ref uvm_reg_bus_op rw);
+      bus_rw bus;
+      if (!$cast(bus, bus_item)) begin
+         `uvm_fatal("NOT_BUS_TYPE", "Provided bus_item is not of the correct type")
+         return;
+      end
+      rw.kind   = bus.read ? UVM_READ : UVM_WRITE;
+      rw.addr   = bus.addr;
+      rw.data   = bus.data[0];
+      rw.status = UVM_IS_OK;
+   endfunction
+
+   virtual function uvm_sequence_item reg2bus_burst(const ref uvm_reg_bus_op rw[$]);
+      bus_rw bus = bus_rw::type_id::create("rw");
+      bus.read = (rw[0].kind == UVM_READ);
+      bus.addr = rw[0].addr;
+      foreach (rw[i]) begin
+         if (rw[i].addr != rw[0].addr + 4*i)
+           `uvm_error("BURST", $sformatf("Access %0d of burst at 'h%0h is at 'h%0h",
+                                         i, rw[0].addr, rw[i].addr))
+         bus.data.push_back(rw[i].data);
+      end
+      return bus;
+   endfunction
+
+   virtual function void bus2reg_burst(uvm_sequence_item bus_item,
+                                       ref uvm_reg_bus_op rw[$]);
+      bus_rw bus;
+      if (!$cast(bus, bus_item)) begin
+         `uvm_fatal("NOT_BUS_TYPE", "Provided bus_item is not of the correct type")
+         return;
+      end
+      if (rw.size() == 0) begin
+         foreach (bus.data[i]) begin
+            uvm_reg_bus_op op;
+            op.kind    = bus.read ? UVM_READ : UVM_WRITE;
+            op.addr    = bus.addr + 4*i;
+            op.byte_en = -1;
+            rw.push_back(op);
+         end
+      end
+      foreach (rw[i]) begin
+         rw[i].data   = bus.data[i];
+         rw[i].status = UVM_IS_OK;
+      end
+   endfunction
+endclass
+
+
+class reg32 extends uvm_reg;
+   uvm_reg_field F;
+
+   `uvm_object_utils(reg32)
+
+   function new(string name = "reg32");
+      super.new(name, 32, UVM_NO_COVERAGE);
+   endfunction
+
+   virtual function void build();
+      F = uvm_reg_field::type_id::create("F");
+      F.configure(this, 32, 0, "RW", 0, 0, 1, 0, 1);
+   endfunction
+endclass
+
+
+class reg64 extends uvm_reg;
+   uvm_reg_field F;
+
+   `uvm_object_utils(reg64)
+
+   function new(string name = "reg64");
+      super.new(name, 64, UVM_NO_COVERAGE);
+   endfunction
+
+   virtual function void build();
+      F = uvm_reg_field::type_id::create("F");
+      F.configure(this, 64, 0, "RW", 0, 0, 1, 0, 1);
+   endfunction
+endclass
+
+
+class reg32_array extends uvm_reg_array;
+   `uvm_object_utils(reg32_array)
+
+   function new(string name = "reg32_array", int unsigned size = 1);
+      super.new(name, size);
+   endfunction
+
+   virtual function uvm_reg create_reg(string name);
+      reg32 rg = reg32::type_id::create(name);
+      rg.build();
+      return rg;
+   endfunction
+endclass
+
+
+class blk extends uvm_reg_block;
+   reg32 R[9];
+   reg64 W;
+   reg32_array A;
+
+   `uvm_object_utils(blk)
+
+   // 0x00-0x14 are adjacent, as are 0x20-0x24
+   static int unsigned offsets[9] = '{'h14, 'h00, 'h08, 'h04, 'h0C, 'h10,
+                                      'h24, 'h20, 'h40};
+
+   function new(string name = "blk");
+      super.new(name, UVM_NO_COVERAGE);
+   endfunction
+
+   virtual function void build();
+      default_map = create_map("", 0, 4, UVM_LITTLE_ENDIAN);
+      foreach (R[i]) begin
+         R[i] = reg32::type_id::create($sformatf("R%0d", i));
+         R[i].configure(this);
+         R[i].build();
+         default_map.add_reg(R[i], offsets[i]);
+      end
+      W = reg64::type_id::create("W");
+      W.configure(this);
+      W.build();
+      default_map.add_reg(W, 'h50);
+      // 0x80-0x94, not materialized
+      A = new("A", 6);
+      A.configure(this);
+      default_map.add_reg_array(A, 'h80);
+   endfunction
+endclass
+
+
+class test extends uvm_test;
+   blk                       model;
+   bus_sequencer             sqr;
+   bus_driver                drv;
+   uvm_reg_predictor#(bus_rw) predictor;
+
+   `uvm_component_utils(test)
+
+   function new(string name = "test", uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   virtual function void build_phase(uvm_phase phase);
+      model = blk::type_id::create("model");
+      model.build();
+      model.lock_model();
+      sqr = bus_sequencer::type_id::create("sqr", this);
+      drv = bus_driver::type_id::create("drv", this);
+      predictor = uvm_reg_predictor#(bus_rw)::type_id::create("predictor", this);
+   endfunction
+
+   virtual function void connect_phase(uvm_phase phase);
+      bus_adapter adapter = new;
+      drv.seq_item_port.connect(sqr.seq_item_export);
+      model.default_map.set_sequencer(sqr, adapter);
+      predictor.map = model.default_map;
+      predictor.adapter = adapter;
+      drv.ap.connect(predictor.bus_in);
+   endfunction
+
+   function void check_lengths(string what, int exp[$]);
+      if (drv.lengths != exp) begin
+         string s;
+         foreach (drv.lengths[i])
+           s = {s, $sformatf(" %0d", drv.lengths[i])};
+         `uvm_error("Test", {what, " used bus transactions of lengths", s})
+      end
+      drv.lengths.delete();
+   endfunction
+
+   virtual task run_phase(uvm_phase phase);
+      uvm_status_e status;
+
+      phase.raise_objection(this);
+
+      // Update: bursts of 4 and 2 at 0x00, 2 at 0x20, a single access
+      // at 0x40, a burst of 2 for the 64-bit register and bursts of 4
+      // and 2 for the array elements at 0x80
+      foreach (model.R[i])
+        model.R[i].set('h1000 + i);
+      model.W.set('h1111_2222_3333_4444);
+      for (int i = 0; i < 6; i++)
+        model.A.set(i, 'h3000 + i);
+      model.update(status);
+      if (status != UVM_IS_OK)
+        `uvm_error("Test", $sformatf("update() returned %s", status.name()))
+      check_lengths("update()", '{4, 2, 2, 1, 2, 4, 2});
+
+      foreach (model.R[i]) begin
+         if (drv.mem[blk::offsets[i]] != 'h1000 + i)
+           `uvm_error("Test", $sformatf("R%0d is 'h%0h in the DUT", i,
+                                        drv.mem[blk::offsets[i]]))
+         if (model.R[i].get_mirrored_value() != 'h1000 + i || model.R[i].needs_update())
+           `uvm_error("Test", $sformatf("R%0d mirror is 'h%0h after update()", i,
+                                        model.R[i].get_mirrored_value()))
+      end
+      if (drv.mem['h50] != 'h3333_4444 || drv.mem['h54] != 'h1111_2222)
+        `uvm_error("Test", "W was not updated in the DUT")
+      for (int i = 0; i < 6; i++) begin
+         if (drv.mem['h80 + 4*i] != 'h3000 + i)
+           `uvm_error("Test", $sformatf("A[%0d] is 'h%0h in the DUT", i,
+                                        drv.mem['h80 + 4*i]))
+         if (model.A.get_mirrored_value(i) != 'h3000 + i || model.A.needs_update(i))
+           `uvm_error("Test", $sformatf("A[%0d] mirror is 'h%0h after update()", i,
+                                        model.A.get_mirrored_value(i)))
+      end
+      if (model.A.get_n_materialized() != 0)
+        `uvm_error("Test", "update() materialized array elements")
+
+      // Nothing to update
+      model.update(status);
+      check_lengths("Second update()", {});
+
+      // Only the registers that need it are updated
+      model.R[3].set('h33);
+      model.R[5].set('h55);
+      model.A.set(1, 'h11);
+      model.A.set(2, 'h22);
+      model.update(status);
+      check_lengths("Partial update()", '{1, 1, 2});
+
+      // Mirror reads all registers in bursts too
+      foreach (model.R[i])
+        drv.mem[blk::offsets[i]] = 'h2000 + i;
+      drv.mem['h50] = 'h5555_6666;
+      drv.mem['h54] = 'h7777_8888;
+      for (int i = 0; i < 6; i++)
+        drv.mem['h80 + 4*i] = 'h4000 + i;
+      model.mirror(status);
+      if (status != UVM_IS_OK)
+        `uvm_error("Test", $sformatf("mirror() returned %s", status.name()))
+      check_lengths("mirror()", '{4, 2, 2, 1, 2, 4, 2});
+
+      foreach (model.R[i])
+        if (model.R[i].get_mirrored_value() != 'h2000 + i)
+          `uvm_error("Test", $sformatf("R%0d mirror is 'h%0h after mirror()", i,
+                                       model.R[i].get_mirrored_value()))
+      if (model.W.get_mirrored_value() != 'h7777_8888_5555_6666)
+        `uvm_error("Test", $sformatf("W mirror is 'h%0h after mirror()",
+                                     model.W.get_mirrored_value()))
+      for (int i = 0; i < 6; i++)
+        if (model.A.get_mirrored_value(i) != 'h4000 + i)
+          `uvm_error("Test", $sformatf("A[%0d] mirror is 'h%0h after mirror()", i,
+                                       model.A.get_mirrored_value(i)))
+
+      // Individual accesses are not affected
+      model.R[0].write(status, 'hABCD);
+      check_lengths("write()", '{1});
+
+      phase.drop_objection(this);
+   endtask
+
+   virtual function void report_phase(uvm_phase phase);
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   endfunction
+endclass
+
+
+initial run_test("test");
+
+endmodule
@@ -0,0 +1,149 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// Injections scheduled with uvm_hdl_inject_add() or, as a batch, with
+// uvm_hdl_inject_add_batch() are applied and released at their
+// scheduled times, with no process of the test waiting for them.
+
+
+module dut();
+
+   wire [7:0]  w;
+   reg  [7:0]  q = 'h0F;
+   reg  [7:0]  d = 'hF0;
+   reg  [63:0] r64 = 0;
+
+   assign w = q;
+
+   always #100 q = d;
+endmodule
+
+
+program top;
+
+import uvm_pkg::*;
+`include "uvm_macros.svh"
+
+task automatic check(string what, logic [63:0] act, logic [63:0] exp);
+   if (act !== exp)
+     `uvm_error("Test", $sformatf("%s is 'h%h instead of 'h%h at %0t",
+                                  what, act, exp, $time))
+endtask
+
+
+initial
+begin
+   int               id_w, n;
+   longint unsigned  start, applied_at, released_at;
+   uvm_hdl_data_t    value;
+
+   #50; // get between updates to q
+
+   // Added at 50
+   n = uvm_hdl_inject_num();
+   void'(uvm_hdl_inject_add("dut.r64", 0, 'h8000_0000_0000_0001, 10, 0,
+                            UVM_HDL_INJECT_FLIP));
+   id_w = uvm_hdl_inject_add("dut.w", 'hAA, 'hFF, 20, 30, UVM_HDL_INJECT_FORCE);
+   void'(uvm_hdl_inject_add("dut.q", 'h05, 'h0F, 0, 0, UVM_HDL_INJECT_FORCE));
+   void'(uvm_hdl_inject_add("dut.q", 0, 0, 200, 0, UVM_HDL_INJECT_RELEASE));
+   void'(uvm_hdl_inject_add("dut.d", 'h3C, 'hFF, 100, 0, UVM_HDL_INJECT_DEPOSIT));
+   if (uvm_hdl_inject_add("dut.nowhere", 0, 0, 0, 0, UVM_HDL_INJECT_DEPOSIT) != -1)
+     `uvm_error("Test", "Injection on a missing path was accepted")
+   if (uvm_hdl_inject_num() != n + 5)
+     `uvm_error("Test", $sformatf("%0d injections instead of %0d",
+                                  uvm_hdl_inject_num(), n + 5))
+
+   #5;  // 55
+   check("q forced with a mask", dut.q, 'h05);
+   check("r64 before its bit flip", dut.r64, 0);
+
+   #10; // 65
+   check("r64 after its bit flip", dut.r64, 'h8000_0000_0000_0001);
+
+   #10; // 75
+   check("w forced", dut.w, 'hAA);
+
+   #30; // 105: w released, q still forced
+   check("w released", dut.w, 'h05);
+   check("q still forced", dut.q, 'h05);
+
+   #50; // 155
+   check("d deposited", dut.d, 'h3C);
+
+   #100; // 255: q released, keeps its value until reassigned
+   check("q released", dut.q, 'h05);
+
+   #50; // 305
+   check("q reassigned", dut.q, 'h3C);
+
+   if (uvm_hdl_inject_get(id_w, start, applied_at, released_at, value) != UVM_HDL_INJECT_DONE)
+     `uvm_error("Test", "The timed force of w is not done")
+   if (start != 70 || applied_at != 70 || released_at != 100 || value[7:0] !== 'hAA)
+     `uvm_error("Test", $sformatf("Timed force of w 'h%h scheduled at %0d applied at %0d released at %0d",
+                                  value[7:0], start, applied_at, released_at))
+   if (uvm_hdl_inject_get_path(id_w) != "dut.w" ||
+       uvm_hdl_inject_get_kind(id_w) != UVM_HDL_INJECT_FORCE)
+     `uvm_error("Test", "Wrong path or kind for the timed force of w")
+   if (uvm_hdl_inject_num_applied() != 5)
+     `uvm_error("Test", $sformatf("%0d injections applied instead of 5",
+                                  uvm_hdl_inject_num_applied()))
+
+   uvm_hdl_inject_report(1);
+
+   uvm_hdl_inject_clear();
+   if (uvm_hdl_inject_num() != 0)
+     `uvm_error("Test", "Injections remain after uvm_hdl_inject_clear()")
+
+   // A campaign scheduled in one call, at 305
+   begin
+      string            paths[]     = '{"dut.d", "dut.r64", "dut.nowhere"};
+      uvm_hdl_data_t    values[]    = '{'h81, 0, 0};
+      uvm_hdl_data_t    masks[]     = '{'hFF, 'h2, 0};
+      longint unsigned  starts[]    = '{10, 20, 0};
+      longint unsigned  durations[] = '{0, 0, 0};
+      int               kinds[]     = '{UVM_HDL_INJECT_DEPOSIT, UVM_HDL_INJECT_FLIP,
+                                        UVM_HDL_INJECT_DEPOSIT};
+      int               ids[]       = new[3];
+
+      if (uvm_hdl_inject_add_batch(paths, values, masks, starts, durations, kinds, ids) != 2 ||
+          ids[0] != 0 || ids[1] != 1 || ids[2] != -1)
+        `uvm_error("Test", $sformatf("Batch injection ids %p", ids))
+      #15; // 320
+      check("d deposited by a batch", dut.d, 'h81);
+      check("r64 before its batch bit flip", dut.r64, 'h8000_0000_0000_0001);
+      #10; // 330
+      check("r64 flipped by a batch", dut.r64, 'h8000_0000_0000_0003);
+      uvm_hdl_inject_clear();
+   end
+
+   begin
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      svr.summarize();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   end
+end
+
+endprogram
@@ -0,0 +1,182 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// uvm_hdl_check_paths() finds the same paths as uvm_hdl_check_path(),
+// with their widths, whether their scope has few or many paths to
+// check, and uvm_reg_mem_hdl_paths_seq accepts a model whose paths
+// are all valid.
+
+
+module regs();
+
+   reg [31:0] r0, r1, r2, r3, r4, r5, r6, r7, r8, r9,
+              r10, r11, r12, r13, r14, r15, r16, r17, r18, r19;
+   reg [63:0] wide;
+   reg [7:0]  mem[0:15];
+
+endmodule
+
+
+module dut();
+
+   regs  blk();
+   reg [15:0] ctl;
+
+endmodule
+
+
+
+program top;
+
+import uvm_pkg::*;
+`include "uvm_macros.svh"
+
+class reg32 extends uvm_reg;
+   uvm_reg_field F;
+
+   function new(string name = "reg32");
+      super.new(name, 32, UVM_NO_COVERAGE);
+   endfunction
+
+   virtual function void build();
+      F = uvm_reg_field::type_id::create("F");
+      F.configure(this, 32, 0, "RW", 0, 0, 1, 0, 1);
+   endfunction
+
+   `uvm_object_utils(reg32)
+endclass
+
+
+class blk_typ extends uvm_reg_block;
+   reg32   R[20];
+   reg32   LO;      // lower half of "wide"
+   uvm_mem M;
+
+   function new(string name = "blk_typ");
+      super.new(name, UVM_NO_COVERAGE);
+   endfunction
+
+   virtual function void build();
+      foreach (R[i]) begin
+         R[i] = reg32::type_id::create($sformatf("R%0d", i));
+         R[i].configure(this, null, $sformatf("r%0d", i));
+         R[i].build();
+      end
+      LO = reg32::type_id::create("LO");
+      LO.configure(this, null, "wide[31:0]");
+      LO.build();
+      M = new("M", 16, 8, "RW", UVM_NO_COVERAGE);
+      M.configure(this, "mem");
+   endfunction
+
+   `uvm_object_utils(blk_typ)
+endclass
+
+
+class top_blk extends uvm_reg_block;
+   blk_typ blk;
+   reg32   CTL;
+
+   function new(string name = "top_blk");
+      super.new(name, UVM_NO_COVERAGE);
+   endfunction
+
+   virtual function void build();
+      CTL = reg32::type_id::create("CTL");
+      CTL.configure(this, null, "ctl");
+      CTL.build();
+      blk = blk_typ::type_id::create("blk");
+      blk.configure(this, "blk");
+      blk.build();
+   endfunction
+
+   `uvm_object_utils(top_blk)
+endclass
+
+
+initial
+begin
+   string paths[$];
+   string p[];
+   int    status[], widths[];
+   int    exp_widths[$];
+   top_blk model;
+
+   // Few paths per scope
+   // Part-selects outside, or reversed from, the declared range are not found
+   paths = '{"dut.ctl", "dut.blk.wide", "dut.nowhere", "dut.none.r0",
+             "dut.blk.wide[31:0]", "dut.blk.wide[99:64]", "dut.blk.wide[0:31]"};
+   exp_widths = '{16, 64, 0, 0, 32, 0, 0};
+
+   // Many paths in the same scope, in no particular order
+   for (int i = 19; i >= 0; i--) begin
+      paths.push_back($sformatf("dut.blk.r%0d", i));
+      exp_widths.push_back(32);
+   end
+   paths.push_back("dut.blk.r20");
+   exp_widths.push_back(0);
+
+   p = new [paths.size()];
+   foreach (paths[i])
+      p[i] = paths[i];
+   status = new [p.size()];
+   widths = new [p.size()];
+
+   if (uvm_hdl_check_paths(p, status, widths) != p.size() - 5)
+      `uvm_error("Test", "uvm_hdl_check_paths() did not find all existing paths")
+
+   foreach (p[i]) begin
+      if (status[i] != (exp_widths[i] != 0))
+         `uvm_error("Test", $sformatf("Status of \"%s\" is %0d", p[i], status[i]))
+      else if (status[i] && widths[i] != exp_widths[i])
+         `uvm_error("Test", $sformatf("Width of \"%s\" is %0d instead of %0d",
+                                      p[i], widths[i], exp_widths[i]))
+      // Not every simulator finds part-selects by name
+      if (p[i][p[i].len()-1] == "]")
+         continue;
+      if (uvm_hdl_check_path(p[i]) != status[i])
+         `uvm_error("Test", $sformatf("uvm_hdl_check_path(\"%s\") disagrees", p[i]))
+   end
+
+   model = new("model");
+   model.build();
+   model.set_hdl_path_root("dut");
+
+   begin
+      uvm_reg_mem_hdl_paths_seq seq;
+      seq = new;
+      seq.model = model;
+      seq.start(null);
+   end
+
+   begin
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      svr.summarize();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   end
+end
+
+endprogram
@@ -0,0 +1,98 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// Throughput of uvm_config_db set and get with 1000 fields in 100
+// scopes, and of gets matching a wildcard scope.
+
+`include "uvm_macros.svh"
+module top;
+
+import uvm_pkg::*;
+`include "../common/perf_bench.svh"
+
+class test extends uvm_test;
+   `uvm_component_utils(test)
+
+   function new(string name = "test", uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   virtual task run_phase(uvm_phase phase);
+      string       scopes[100];
+      string       fields[1000];
+      int unsigned n = perf_bench::n_ops(20000);
+      perf_bench   b;
+      int          v;
+
+      phase.raise_objection(this);
+
+      foreach (scopes[i])
+        scopes[i] = $sformatf("c%0d", i);
+      foreach (fields[i])
+        fields[i] = $sformatf("f%0d", i);
+
+      b = new("config_db_set", 2000);
+      b.start();
+      for (int i = 0; i < n; i++)
+        uvm_config_db#(int)::set(this, scopes[i % 100], fields[i % 1000], i);
+      b.stop(n);
+
+      b = new("config_db_get", 2000);
+      b.start();
+      for (int i = 0; i < n; i++) begin
+         if (!uvm_config_db#(int)::get(this, scopes[i % 100], fields[i % 1000], v) ||
+             v % 1000 != i % 1000 || v + 1000 < n) begin
+            `uvm_error("Test", $sformatf("Wrong value %0d for %s.%s", v,
+                                         scopes[i % 100], fields[i % 1000]))
+            break;
+         end
+      end
+      b.stop(n);
+
+      uvm_config_db#(int)::set(this, "c1*", "wild", 7);
+      b = new("config_db_get_wildcard", 2000);
+      b.start();
+      for (int i = 0; i < n; i++) begin
+         bit found = uvm_config_db#(int)::get(this, scopes[i % 100], "wild", v);
+         if (found != (scopes[i % 100].substr(0, 1) == "c1")) begin
+            `uvm_error("Test", {"Wrong wildcard match for ", scopes[i % 100]})
+            break;
+         end
+      end
+      b.stop(n);
+
+      phase.drop_objection(this);
+   endtask
+
+   virtual function void report_phase(uvm_phase phase);
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   endfunction
+endclass
+
+
+initial run_test("test");
+
+endmodule
@@ -0,0 +1,114 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// Throughput of factory creation of an object with a type override,
+// an instance override and unrelated instance overrides registered.
+
+`include "uvm_macros.svh"
+module top;
+
+import uvm_pkg::*;
+`include "../common/perf_bench.svh"
+
+class base_obj extends uvm_object;
+   `uvm_object_utils(base_obj)
+   function new(string name = "base_obj");
+      super.new(name);
+   endfunction
+endclass
+
+class type_obj extends base_obj;
+   `uvm_object_utils(type_obj)
+   function new(string name = "type_obj");
+      super.new(name);
+   endfunction
+endclass
+
+class inst_obj extends base_obj;
+   `uvm_object_utils(inst_obj)
+   function new(string name = "inst_obj");
+      super.new(name);
+   endfunction
+endclass
+
+class other_obj extends uvm_object;
+   `uvm_object_utils(other_obj)
+   function new(string name = "other_obj");
+      super.new(name);
+   endfunction
+endclass
+
+
+class test extends uvm_test;
+   `uvm_component_utils(test)
+
+   function new(string name = "test", uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   virtual function void build_phase(uvm_phase phase);
+      factory.set_type_override_by_type(base_obj::get_type(), type_obj::get_type());
+      factory.set_inst_override_by_type(base_obj::get_type(), inst_obj::get_type(),
+                                        "top.p3.*");
+      for (int i = 0; i < 50; i++)
+        factory.set_inst_override_by_type(other_obj::get_type(), type_obj::get_type(),
+                                          $sformatf("top.x%0d.*", i));
+   endfunction
+
+   virtual task run_phase(uvm_phase phase);
+      string       paths[16];
+      int unsigned n = perf_bench::n_ops(20000);
+      perf_bench   b;
+      base_obj     obj;
+
+      phase.raise_objection(this);
+
+      foreach (paths[i])
+        paths[i] = $sformatf("top.p%0d", i);
+
+      b = new("factory_create_override", 2000);
+      b.start();
+      for (int i = 0; i < n; i++) begin
+         obj = base_obj::type_id::create("obj", null, paths[i % 16]);
+         if (obj.get_type_name() != ((i % 16 == 3) ? "inst_obj" : "type_obj")) begin
+            `uvm_error("Test", {"Created a ", obj.get_type_name(), " in ", paths[i % 16]})
+            break;
+         end
+      end
+      b.stop(n);
+
+      phase.drop_objection(this);
+   endtask
+
+   virtual function void report_phase(uvm_phase phase);
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   endfunction
+endclass
+
+
+initial run_test("test");
+
+endmodule
@@ -0,0 +1,100 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// Throughput of uvm_root::find_all on a 4-level hierarchy of 1111 components.
+
+`include "uvm_macros.svh"
+module top;
+
+import uvm_pkg::*;
+`include "../common/perf_bench.svh"
+
+class node extends uvm_component;
+   static string prefix[3] = '{"u", "s", "l"};
+   int level;
+
+   `uvm_component_utils(node)
+
+   function new(string name, uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   virtual function void build_phase(uvm_phase phase);
+      if (level == 3)
+        return;
+      for (int i = 0; i < 10; i++) begin
+         node n = new($sformatf("%s%0d", prefix[level], i), this);
+         n.level = level + 1;
+      end
+   endfunction
+endclass
+
+
+class test extends uvm_test;
+   node hier;
+
+   `uvm_component_utils(test)
+
+   function new(string name = "test", uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   virtual function void build_phase(uvm_phase phase);
+      hier = new("hier", this);
+   endfunction
+
+   virtual task run_phase(uvm_phase phase);
+      int unsigned n = perf_bench::n_ops(200);
+      perf_bench   b;
+      uvm_component comps[$];
+
+      phase.raise_objection(this);
+
+      b = new("find_all", 5);
+      b.start();
+      for (int i = 0; i < n; i++) begin
+         comps.delete();
+         uvm_top.find_all("*.s3.*", comps);
+         if (comps.size() != 100) begin
+            `uvm_error("Test", $sformatf("find_all found %0d components instead of 100",
+                                         comps.size()))
+            break;
+         end
+      end
+      b.stop(n);
+
+      phase.drop_objection(this);
+   endtask
+
+   virtual function void report_phase(uvm_phase phase);
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   endfunction
+endclass
+
+
+initial run_test("test");
+
+endmodule
@@ -0,0 +1,110 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// Throughput of reports filtered out by verbosity in the `uvm_info
+// macro, of reports with no action filtered out by the report server
+// and of reports caught by a report catcher.
+
+`include "uvm_macros.svh"
+module top;
+
+import uvm_pkg::*;
+`include "../common/perf_bench.svh"
+
+class counter extends uvm_report_catcher;
+   int count[string];
+
+   function new(string name = "counter");
+      super.new(name);
+   endfunction
+
+   function action_e catch();
+      string id = get_id();
+      if (count.exists(id))
+        count[id]++;
+      else
+        count[id] = 1;
+      return (id == "CAUGHT") ? CAUGHT : THROW;
+   endfunction
+endclass
+
+
+class test extends uvm_test;
+   `uvm_component_utils(test)
+
+   function new(string name = "test", uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   virtual task run_phase(uvm_phase phase);
+      int unsigned n = perf_bench::n_ops(200000);
+      perf_bench   b;
+      counter      ctr = new;
+
+      phase.raise_objection(this);
+
+      uvm_report_cb::add(this, ctr);
+      set_report_verbosity_level(UVM_LOW);
+      set_report_id_action("QUIET", UVM_NO_ACTION);
+
+      b = new("report_filtered_verbosity", 100000);
+      b.start();
+      for (int i = 0; i < n; i++)
+        `uvm_info("FILT", "filtered out", UVM_HIGH)
+      b.stop(n);
+
+      b = new("report_no_action", 50000);
+      b.start();
+      for (int i = 0; i < n; i++)
+        uvm_report_info("QUIET", "no action", UVM_NONE);
+      b.stop(n);
+
+      n = perf_bench::n_ops(50000);
+      b = new("report_caught", 10000);
+      b.start();
+      for (int i = 0; i < n; i++)
+        `uvm_info("CAUGHT", "caught", UVM_NONE)
+      b.stop(n);
+
+      if (ctr.count.exists("FILT") || ctr.count.exists("QUIET"))
+        `uvm_error("Test", "Filtered reports reached the report catcher")
+      if (!ctr.count.exists("CAUGHT") || ctr.count["CAUGHT"] != n)
+        `uvm_error("Test", "Reports were not all caught")
+
+      uvm_report_cb::delete(this, ctr);
+
+      phase.drop_objection(this);
+   endtask
+
+   virtual function void report_phase(uvm_phase phase);
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   endfunction
+endclass
+
+
+initial run_test("test");
+
+endmodule
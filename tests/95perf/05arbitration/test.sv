@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// Throughput of sequencer arbitration between 8 sequences of different
+// priorities, for each arbitration mode, with a zero-time driver.
+
+`include "uvm_macros.svh"
+module top;
+
+import uvm_pkg::*;
+`include "../common/perf_bench.svh"
+
+class item extends uvm_sequence_item;
+   int src;
+
+   `uvm_object_utils(item)
+
+   function new(string name = "item");
+      super.new(name);
+   endfunction
+endclass
+
+
+class seq extends uvm_sequence #(item);
+   int n_items;
+   int src;
+
+   `uvm_object_utils(seq)
+
+   function new(string name = "seq");
+      super.new(name);
+   endfunction
+
+   virtual task body();
+      repeat (n_items) begin
+         req = item::type_id::create("req");
+         start_item(req);
+         req.src = src;
+         finish_item(req);
+      end
+   endtask
+endclass
+
+
+class driver extends uvm_driver #(item);
+   int count[8];
+
+   `uvm_component_utils(driver)
+
+   function new(string name, uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   virtual task run_phase(uvm_phase phase);
+      forever begin
+         seq_item_port.get_next_item(req);
+         count[req.src]++;
+         seq_item_port.item_done();
+      end
+   endtask
+endclass
+
+
+class test extends uvm_test;
+   uvm_sequencer #(item) sqr;
+   driver                drv;
+
+   `uvm_component_utils(test)
+
+   function new(string name = "test", uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   virtual function void build_phase(uvm_phase phase);
+      sqr = new("sqr", this);
+      drv = driver::type_id::create("drv", this);
+   endfunction
+
+   virtual function void connect_phase(uvm_phase phase);
+      drv.seq_item_port.connect(sqr.seq_item_export);
+   endfunction
+
+   virtual task run_phase(uvm_phase phase);
+      SEQ_ARB_TYPE modes[6] = '{SEQ_ARB_FIFO, SEQ_ARB_WEIGHTED, SEQ_ARB_RANDOM,
+                                SEQ_ARB_STRICT_FIFO, SEQ_ARB_STRICT_RANDOM,
+                                SEQ_ARB_USER};
+      int unsigned n = perf_bench::n_ops(2000);
+
+      phase.raise_objection(this);
+
+      foreach (modes[m]) begin
+         perf_bench b = new({"sequencer_arb_", modes[m].name()}, 5000);
+
+         sqr.set_arbitration(modes[m]);
+         foreach (drv.count[i])
+           drv.count[i] = 0;
+
+         b.start();
+         for (int i = 0; i < 8; i++) begin
+            fork
+               automatic int k = i;
+               begin
+                  seq s = seq::type_id::create($sformatf("seq%0d", k));
+                  s.n_items = n;
+                  s.src = k;
+                  s.start(sqr, null, 100 * (k + 1));
+               end
+            join_none
+         end
+         wait fork;
+         b.stop(8 * n);
+
+         foreach (drv.count[i])
+           if (drv.count[i] != n)
+             `uvm_error("Test", $sformatf("%s: driver received %0d items of sequence %0d instead of %0d",
+                                          modes[m].name(), drv.count[i], i, n))
+      end
+
+      phase.drop_objection(this);
+   endtask
+
+   virtual function void report_phase(uvm_phase phase);
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   endfunction
+endclass
+
+
+initial run_test("test");
+
+endmodule
@@ -0,0 +1,100 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// Throughput of packing and unpacking an object with field automation.
+
+`include "uvm_macros.svh"
+module top;
+
+import uvm_pkg::*;
+`include "../common/perf_bench.svh"
+
+class packet extends uvm_object;
+   rand bit [7:0]    kind;
+   rand bit [31:0]   addr;
+   rand bit [7:0]    data[16];
+   rand int unsigned tag;
+   rand bit [63:0]   stamp;
+
+   `uvm_object_utils_begin(packet)
+      `uvm_field_int(kind, UVM_ALL_ON)
+      `uvm_field_int(addr, UVM_ALL_ON)
+      `uvm_field_sarray_int(data, UVM_ALL_ON)
+      `uvm_field_int(tag, UVM_ALL_ON)
+      `uvm_field_int(stamp, UVM_ALL_ON)
+   `uvm_object_utils_end
+
+   function new(string name = "packet");
+      super.new(name);
+   endfunction
+endclass
+
+
+class test extends uvm_test;
+   `uvm_component_utils(test)
+
+   function new(string name = "test", uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   virtual task run_phase(uvm_phase phase);
+      int unsigned n = perf_bench::n_ops(20000);
+      perf_bench   b;
+      packet       p = new("p");
+      packet       q = new("q");
+      byte unsigned bytes[];
+
+      phase.raise_objection(this);
+
+      void'(p.randomize());
+
+      b = new("pack_bytes", 5000);
+      b.start();
+      for (int i = 0; i < n; i++)
+        void'(p.pack_bytes(bytes));
+      b.stop(n);
+
+      b = new("unpack_bytes", 5000);
+      b.start();
+      for (int i = 0; i < n; i++)
+        void'(q.unpack_bytes(bytes));
+      b.stop(n);
+
+      if (!p.compare(q))
+        `uvm_error("Test", "Unpacked packet differs from the packed one")
+
+      phase.drop_objection(this);
+   endtask
+
+   virtual function void report_phase(uvm_phase phase);
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   endfunction
+endclass
+
+
+initial run_test("test");
+
+endmodule
@@ -0,0 +1,143 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+// Throughput of the prediction of register values in a locked model
+// of 64 registers with 4 fields each.
+
+`include "uvm_macros.svh"
+module top;
+
+import uvm_pkg::*;
+`include "../common/perf_bench.svh"
+
+class reg32 extends uvm_reg;
+   uvm_reg_field f[4];
+
+   `uvm_object_utils(reg32)
+
+   function new(string name = "reg32");
+      super.new(name, 32, UVM_NO_COVERAGE);
+   endfunction
+
+   virtual function void build();
+      string policies[4] = '{"RW", "RW", "W1C", "RO"};
+      foreach (f[i]) begin
+         f[i] = uvm_reg_field::type_id::create($sformatf("f%0d", i));
+         f[i].configure(this, 8, 8 * i, policies[i], 0, 0, 1, 0, 1);
+      end
+   endfunction
+endclass
+
+
+class blk extends uvm_reg_block;
+   reg32 R[64];
+
+   `uvm_object_utils(blk)
+
+   function new(string name = "blk");
+      super.new(name, UVM_NO_COVERAGE);
+   endfunction
+
+   virtual function void build();
+      default_map = create_map("", 0, 4, UVM_LITTLE_ENDIAN);
+      foreach (R[i]) begin
+         R[i] = reg32::type_id::create($sformatf("R%0d", i));
+         R[i].configure(this);
+         R[i].build();
+         default_map.add_reg(R[i], 4 * i);
+      end
+   endfunction
+endclass
+
+
+class test extends uvm_test;
+   blk model;
+
+   `uvm_component_utils(test)
+
+   function new(string name = "test", uvm_component parent = null);
+      super.new(name, parent);
+   endfunction
+
+   virtual function void build_phase(uvm_phase phase);
+      model = blk::type_id::create("model");
+      model.build();
+      model.lock_model();
+   endfunction
+
+   virtual task run_phase(uvm_phase phase);
+      int unsigned n = perf_bench::n_ops(50000);
+      perf_bench   b;
+
+      phase.raise_objection(this);
+
+      b = new("reg_predict_read", 10000);
+      b.start();
+      for (int i = 0; i < n; i++)
+        void'(model.R[i % 64].predict(i, -1, UVM_PREDICT_READ, UVM_FRONTDOOR,
+                                      model.default_map));
+      b.stop(n);
+
+      foreach (model.R[i])
+        void'(model.R[i].predict('h00FF_0000, -1, UVM_PREDICT_DIRECT));
+
+      b = new("reg_predict_write", 10000);
+      b.start();
+      for (int i = 0; i < n; i++)
+        void'(model.R[i % 64].predict(i & 'h00FF_FFFF, -1, UVM_PREDICT_WRITE,
+                                      UVM_FRONTDOOR, model.default_map));
+      b.stop(n);
+
+      // RW fields hold the last write, W1C fields are cleared by the
+      // 1s written and RO fields keep their value
+      foreach (model.R[i]) begin
+         uvm_reg_data_t clr = 0;
+         uvm_reg_data_t last = 0;
+         uvm_reg_data_t exp;
+         for (int k = i; k < n; k += 64) begin
+            clr |= k & 'h00FF_0000;
+            last = k & 'h0000_FFFF;
+         end
+         exp = last | ('h00FF_0000 & ~clr);
+         if (model.R[i].get_mirrored_value() != exp) begin
+            `uvm_error("Test", $sformatf("R%0d mirror is 'h%h instead of 'h%h", i,
+                                         model.R[i].get_mirrored_value(), exp))
+            break;
+         end
+      end
+
+      phase.drop_objection(this);
+   endtask
+
+   virtual function void report_phase(uvm_phase phase);
+      uvm_report_server svr;
+      svr = _global_reporter.get_report_server();
+
+      if (svr.get_severity_count(UVM_FATAL) == 0 &&
+          svr.get_severity_count(UVM_ERROR) == 0)
+         $write("** UVM TEST PASSED **\n");
+      else
+         $write("!! UVM TEST FAILED !!\n");
+   endfunction
+endclass
+
+
+initial run_test("test");
+
+endmodule
@@ -0,0 +1,59 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+/*
+ * In-memory stand-in for svdpi.h, see vpi_user.h. An open array
+ * handle is a uvm_standin_array_t describing a contiguous array of
+ * 32-bit elements, or of elements of 'elem_size' bytes if not 0
+ * (e.g. sizeof(const char*) for strings), indexed from 0.
+ */
+
+#ifndef SVDPI_H
+#define SVDPI_H
+
+#include "vpi_user.h"
+
+typedef unsigned char svLogic;
+typedef s_vpi_vecval  svLogicVecVal;
+
+typedef struct uvm_standin_array_s {
+  void *data;
+  int   size;
+  int   elem_size;
+} uvm_standin_array_t;
+
+typedef const uvm_standin_array_t *svOpenArrayHandle;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void   *svGetArrayPtr(const svOpenArrayHandle h);
+void   *svGetArrElemPtr1(const svOpenArrayHandle h, int indx1);
+int     svSize(const svOpenArrayHandle h, int d);
+int     svLow(const svOpenArrayHandle h, int d);
+svLogic svGetBitselLogic(const svLogicVecVal *s, int i);
+void    svGetPartselLogic(svLogicVecVal *d, const svLogicVecVal *s, int i, int w);
+void    svPutPartselLogic(svLogicVecVal *d, const svLogicVecVal s, int i, int w);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,54 @@
+##----------------------------------------------------------------------
+##   Copyright 2011 Cadence Design Systems, Inc.
+##   All Rights Reserved Worldwide
+##
+##   Licensed under the Apache License, Version 2.0 (the
+##   "License"); you may not use this file except in
+##   compliance with the License.  You may obtain a copy of
+##   the License at
+##
+##       http://www.apache.org/licenses/LICENSE-2.0
+##
+##   Unless required by applicable law or agreed to in
+##   writing, software distributed under the License is
+##   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+##   CONDITIONS OF ANY KIND, either express or implied.  See
+##   the License for the specific language governing
+##   permissions and limitations under the License.
+##----------------------------------------------------------------------
+
+#
+# Builds the native DPI benchmark harness against the in-memory VPI
+# stand-in and runs it. No simulator is used: the C++ compiler is
+# taken from $CXX (default g++) and extra harness arguments from
+# $UVM_PERF_ARGS (e.g. "-scale 50").
+#
+
+unlink("uvm_dpi_bench", "native.log");
+if ($opt_c) {
+  return 0;
+}
+
+$cxx = $ENV{'CXX'} || "g++";
+if (system("$cxx -O2 -pthread -I. -I$uvm_home/src/dpi -o uvm_dpi_bench " .
+           "uvm_dpi_bench.cc uvm_dpi_standin.c $uvm_home/src/dpi/uvm_dpi.cc " .
+           "> native.log 2>&1") != 0) {
+  $post_test = "cannot build the native harness, see native.log";
+  return 1;
+}
+
+system("./uvm_dpi_bench $ENV{'UVM_PERF_ARGS'} >> native.log 2>&1");
+
+$passed = 0;
+if (open(LOG, "< native.log")) {
+  while ($_ = <LOG>) {
+    $passed = 1 if m/UVM TEST PASSED/;
+    if (m/UVM TEST FAILED/) {
+      $passed = 0;
+      last;
+    }
+  }
+  close(LOG);
+}
+$post_test = "native harness, see native.log";
+return $passed ? 0 : 1;
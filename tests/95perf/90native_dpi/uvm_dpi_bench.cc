@@ -0,0 +1,927 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+/*
+ * Native benchmark harness for the UVM DPI code.
+ *
+ * Links distrib/src/dpi/uvm_dpi.cc against the in-memory VPI/svdpi
+ * stand-in (uvm_dpi_standin.c) and measures the throughput of the
+ * routines on the hot paths of the SystemVerilog library: regular
+ * expression matching, glob conversion, command-line scanning and HDL
+ * access, batch HDL path checks, the HDL injection scheduler, resource
+ * snapshots, reference model pools, and the overhead of the DPI
+ * profile. Results are checked for correctness and their throughput
+ * against a baseline, and are printed as
+ *
+ *   UVM_PERF <benchmark> <ops/s> ops/s baseline <ops/s>
+ *
+ * Build and run (see test.pl):
+ *
+ *   g++ -O2 -pthread -I. -I$UVM_HOME/src/dpi -o uvm_dpi_bench \
+ *       uvm_dpi_bench.cc uvm_dpi_standin.c $UVM_HOME/src/dpi/uvm_dpi.cc
+ *   ./uvm_dpi_bench [-v] [-scale <percent>] [-n <percent>]
+ *
+ * -scale scales the baselines (0 disables the throughput checks),
+ * -n scales the number of iterations of each benchmark.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vpi_user.h"
+#include "svdpi.h"
+#include "uvm_dpi_standin.h"
+
+extern "C" {
+int uvm_re_match(const char *re, const char *str);
+const char *uvm_glob_to_re(const char *glob);
+const char *dpi_get_next_arg_c();
+int uvm_hdl_check_path(char *path);
+int uvm_hdl_check_paths(const svOpenArrayHandle paths,
+                        const svOpenArrayHandle status,
+                        const svOpenArrayHandle widths);
+int uvm_hdl_read(char *path, p_vpi_vecval value);
+int uvm_hdl_deposit(char *path, p_vpi_vecval value);
+int uvm_hdl_force(char *path, p_vpi_vecval value);
+int uvm_hdl_release(char *path);
+int uvm_hdl_inject_add(char *path, p_vpi_vecval value, p_vpi_vecval mask,
+                       unsigned long long start, unsigned long long duration,
+                       int kind);
+int uvm_hdl_inject_add_batch(const svOpenArrayHandle paths,
+                             const svOpenArrayHandle values,
+                             const svOpenArrayHandle masks,
+                             const svOpenArrayHandle starts,
+                             const svOpenArrayHandle durations,
+                             const svOpenArrayHandle kinds,
+                             const svOpenArrayHandle ids);
+void uvm_hdl_inject_clear();
+int uvm_hdl_inject_num();
+int uvm_hdl_inject_num_applied();
+int uvm_hdl_inject_get(int id, unsigned long long *start,
+                       unsigned long long *applied_at,
+                       unsigned long long *released_at,
+                       p_vpi_vecval value);
+int uvm_rsrc_snap_create(const char *filename);
+void uvm_rsrc_snap_put(const char *name, const char *scope, const char *tag,
+                       unsigned int precedence, int flags,
+                       int name_pos, int type_pos,
+                       const svOpenArrayHandle words, int num_words);
+int uvm_rsrc_snap_close();
+int uvm_rsrc_snap_open(const char *filename);
+int uvm_rsrc_snap_next(const char **name, const char **scope, const char **tag,
+                       unsigned int *precedence, int *flags,
+                       int *name_pos, int *type_pos, int *num_words);
+void uvm_rsrc_snap_get_words(const svOpenArrayHandle words);
+int uvm_refmodel_register(const char *name,
+                          int (*fn)(void *ctx, const unsigned int *in, int n_in,
+                                    unsigned int *out, int max_out),
+                          void *ctx);
+int uvm_refmodel_pool_new(const char *model, int n_threads, int max_out);
+void uvm_refmodel_pool_free(int h);
+int uvm_refmodel_num_threads(int h);
+int uvm_refmodel_pending(int h);
+int uvm_refmodel_submit(int h, const svOpenArrayHandle words, int n_words);
+int uvm_refmodel_collect(int h, const svOpenArrayHandle words,
+                         const svOpenArrayHandle lens, int n);
+unsigned long long uvm_wallclock_ns();
+void uvm_dpi_profile_enable(int on);
+void uvm_dpi_profile_reset();
+int uvm_dpi_profile_num();
+const char *uvm_dpi_profile_name(int id);
+unsigned long long uvm_dpi_profile_calls(int id);
+int uvm_dpi_profile_num_buckets();
+unsigned long long uvm_dpi_profile_bucket(int id, int b);
+}
+
+
+#define N_SIGNALS   4096
+#define N_PATTERNS  16
+#define N_MISSES    512   // more than the compiled regex cache holds
+
+static double scale = 1.0;
+static double iters = 1.0;
+static int n_fails = 0;
+
+static char signals[N_SIGNALS][64];
+
+
+static void check(int cond, const char *what)
+{
+  if (cond)
+    return;
+  printf("UVM_ERROR: %s\n", what);
+  n_fails++;
+}
+
+
+static unsigned long n_ops(unsigned long n)
+{
+  unsigned long k = (unsigned long) (n * iters);
+  return (k == 0) ? 1 : k;
+}
+
+
+static unsigned long long t_start;
+
+static void start()
+{
+  t_start = uvm_wallclock_ns();
+}
+
+
+static void stop(const char *name, unsigned long ops, double baseline)
+{
+  unsigned long long ns = uvm_wallclock_ns() - t_start;
+  double rate;
+
+  if (ns == 0)
+    ns = 1;
+  rate = ops * 1e9 / ns;
+  printf("UVM_PERF %s %.0f ops/s baseline %.0f\n", name, rate, baseline * scale);
+  if (rate < baseline * scale) {
+    printf("UVM_ERROR: %s is below its baseline\n", name);
+    n_fails++;
+  }
+}
+
+
+//--------------------------------------------------------------------
+// Regular expressions
+//--------------------------------------------------------------------
+
+static void bench_regex()
+{
+  static const char *globs[N_PATTERNS] = {
+    "*", "top.*", "top.env.*", "*.agent?.*", "top.env.agent[0-9]*",
+    "*driver*", "*.monitor", "top.env.scoreboard", "/^top\\.env\\.a.*/",
+    "top.env.agent*.sqr", "*.sqr*", "top.*.drv", "top.env.agent1.*",
+    "*.cov", "top.env.+", "top.env.agent?.mon"
+  };
+  static const char *names[] = {
+    "top", "top.env", "top.env.agent0", "top.env.agent1.drv",
+    "top.env.agent2.mon", "top.env.agent3.sqr", "top.env.scoreboard",
+    "top.env.agent0.driver_cb", "top.env.agent1.monitor", "top.env.cov"
+  };
+  const int n_names = sizeof(names) / sizeof(names[0]);
+  char res[N_PATTERNS][2048];
+  char miss[N_MISSES][32];
+  unsigned long i, n;
+  volatile int sink = 0;
+
+  // Known results
+  check(strcmp(uvm_glob_to_re("top.*"), "/^top\\..*$/") == 0, "uvm_glob_to_re(\"top.*\")");
+  check(uvm_re_match(uvm_glob_to_re("top.*"), "top.env") == 0, "top.* matches top.env");
+  check(uvm_re_match(uvm_glob_to_re("top.*"), "tops") != 0, "top.* does not match tops");
+  check(uvm_re_match(uvm_glob_to_re("*.agent?.*"), "top.env.agent1.drv") == 0,
+        "*.agent?.* matches top.env.agent1.drv");
+  check(uvm_re_match("/^a+$/", "aaa") == 0, "/^a+$/ matches aaa");
+
+  for (i = 0; i < N_PATTERNS; i++)
+    strcpy(res[i], uvm_glob_to_re(globs[i]));
+
+  n = n_ops(500000);
+  start();
+  for (i = 0; i < n; i++)
+    sink += uvm_glob_to_re(globs[i % N_PATTERNS])[1];
+  stop("uvm_glob_to_re", n, 1000000);
+
+  n = n_ops(500000);
+  start();
+  for (i = 0; i < n; i++)
+    sink += uvm_re_match(res[i % N_PATTERNS], names[(i / N_PATTERNS) % n_names]);
+  stop("uvm_re_match_cached", n, 200000);
+
+  // Two hot expressions with the same hash stay cached
+  n = n_ops(500000);
+  start();
+  for (i = 0; i < n; i++)
+    sink += uvm_re_match((i & 1) ? "/^.*\\.monitor$/" : "/^.*\\.sqr.*$/",
+                         names[(i / 2) % n_names]);
+  stop("uvm_re_match_cached_colliding", n, 2000000);
+
+  // Every expression evicts a previously compiled one
+  for (i = 0; i < N_MISSES; i++)
+    sprintf(miss[i], "/^top\\.c%lu\\..*$/", i);
+  n = n_ops(50000);
+  start();
+  for (i = 0; i < n; i++)
+    sink += uvm_re_match(miss[i % N_MISSES], "top.c1.x");
+  stop("uvm_re_match_uncached", n, 5000);
+}
+
+
+//--------------------------------------------------------------------
+// Command line
+//--------------------------------------------------------------------
+
+static void bench_cmdline()
+{
+  static char *args[300];
+  static char *f_args[70];
+  static char buf[400][32];
+  int argc = 0, k = 0, i;
+  unsigned long n, p;
+  int per_pass, count;
+  const char *a;
+
+  // 256 arguments plus a -f file of 64 arguments
+  args[argc++] = (char*) "simv";
+  for (i = 0; i < 128; i++) {
+    sprintf(buf[k], "+UVM_ARG%d=%d", i, i);
+    args[argc++] = buf[k++];
+  }
+  args[argc++] = (char*) "-f";
+  args[argc++] = (char*) f_args;
+  for (i = 0; i < 64; i++) {
+    sprintf(buf[k], "+F_ARG%d", i);
+    f_args[i] = buf[k++];
+  }
+  f_args[64] = NULL;
+  for (i = 0; i < 126; i++) {
+    sprintf(buf[k], "+uvm_set_config_int=*,f%d,%d", i, i);
+    args[argc++] = buf[k++];
+  }
+  args[argc] = NULL;
+  uvm_standin_set_argv(argc, args);
+
+  // Every argument, "-f" and the "__-f__" end marker
+  per_pass = 1 + 128 + 1 + 64 + 1 + 126;
+  count = 0;
+  while ((a = dpi_get_next_arg_c()) != NULL)
+    count++;
+  check(count == per_pass, "dpi_get_next_arg_c argument count");
+
+  n = n_ops(20000);
+  start();
+  for (p = 0; p < n; p++)
+    while (dpi_get_next_arg_c() != NULL)
+      ;
+  stop("dpi_get_next_arg_c", n * per_pass, 2000000);
+}
+
+
+//--------------------------------------------------------------------
+// HDL access
+//--------------------------------------------------------------------
+
+static void bench_hdl()
+{
+  s_vpi_vecval v[4], r[4];
+  unsigned long i, n;
+  volatile int sink = 0;
+
+  for (i = 0; i < N_SIGNALS; i++) {
+    sprintf(signals[i], "top.dut.blk%lu.reg%lu", i / 64, i % 64);
+    uvm_standin_add_signal(signals[i], (i % 4 == 0) ? 64 : 32);
+  }
+
+  check(uvm_hdl_check_path(signals[7]) == 1, "uvm_hdl_check_path on an existing path");
+  check(uvm_hdl_check_path((char*) "top.dut.nowhere") == 0,
+        "uvm_hdl_check_path on a missing path");
+
+  n = n_ops(1000000);
+  start();
+  for (i = 0; i < n; i++)
+    sink += uvm_hdl_check_path(signals[i % N_SIGNALS]);
+  stop("uvm_hdl_check_path", n, 500000);
+
+  n = n_ops(1000000);
+  start();
+  for (i = 0; i < n; i++) {
+    v[0].aval = (unsigned int) i; v[0].bval = 0;
+    v[1].aval = (unsigned int) ~i; v[1].bval = 0;
+    sink += uvm_hdl_deposit(signals[i % N_SIGNALS], v);
+  }
+  stop("uvm_hdl_deposit", n, 300000);
+
+  n = n_ops(1000000);
+  start();
+  for (i = 0; i < n; i++)
+    sink += uvm_hdl_read(signals[i % N_SIGNALS], r);
+  stop("uvm_hdl_read", n, 300000);
+
+  // The last deposit to each signal is read back
+  for (i = 0; i < N_SIGNALS; i++) {
+    unsigned long last = n_ops(1000000) - 1;
+    unsigned long k = last - ((last - i) % N_SIGNALS);
+    if (k > last)
+      continue;
+    uvm_hdl_read(signals[i], r);
+    if (r[0].aval != (unsigned int) k ||
+        (i % 4 == 0 && r[1].aval != (unsigned int) ~k)) {
+      check(0, "uvm_hdl_read returns the deposited value");
+      break;
+    }
+  }
+
+  // A deposit does not override a force
+  v[0].aval = 0x1234; v[0].bval = 0; v[1] = v[0];
+  uvm_hdl_force(signals[1], v);
+  v[0].aval = 0x5678;
+  uvm_hdl_deposit(signals[1], v);
+  uvm_hdl_read(signals[1], r);
+  check(r[0].aval == 0x1234 && uvm_standin_is_forced(signals[1]), "uvm_hdl_force");
+  uvm_hdl_release(signals[1]);
+  check(!uvm_standin_is_forced(signals[1]), "uvm_hdl_release");
+
+  n = n_ops(500000);
+  start();
+  for (i = 0; i < n; i++) {
+    v[0].aval = (unsigned int) i;
+    sink += uvm_hdl_force(signals[i % N_SIGNALS], v);
+    sink += uvm_hdl_release(signals[i % N_SIGNALS]);
+  }
+  stop("uvm_hdl_force_release", n, 150000);
+
+  check(uvm_hdl_read((char*) "top.dut.nowhere", r) == 0, "uvm_hdl_read on a missing path");
+}
+
+
+//--------------------------------------------------------------------
+// Batch HDL path checks
+//--------------------------------------------------------------------
+
+#define N_EXTRA_PATHS  (N_SIGNALS / 8)
+#define N_CHECK_PATHS  (N_SIGNALS + N_EXTRA_PATHS)
+
+static void bench_hdl_check_paths()
+{
+  static const char *paths[N_CHECK_PATHS];
+  static char extra[N_EXTRA_PATHS][64];
+  static int status[N_CHECK_PATHS], widths[N_CHECK_PATHS];
+  uvm_standin_array_t paths_a  = { paths, N_CHECK_PATHS, sizeof(const char*) };
+  uvm_standin_array_t status_a = { status, N_CHECK_PATHS };
+  uvm_standin_array_t widths_a = { widths, N_CHECK_PATHS };
+  uvm_standin_array_t short_a  = { status, 1 };
+  unsigned long i, n, lookups;
+  int found;
+  volatile int sink = 0;
+
+  // The registers of bench_hdl in reverse order, then part-selects,
+  // missing registers of existing blocks, registers of missing blocks,
+  // missing paths without a scope, part-selects out of the range of a
+  // 64-bit register and part-selects in the wrong direction
+  for (i = 0; i < N_SIGNALS; i++)
+    paths[i] = signals[N_SIGNALS - 1 - i];
+  for (i = 0; i < N_EXTRA_PATHS; i++) {
+    switch (i % 8) {
+    case 0: sprintf(extra[i], "%s[15:0]", signals[i]); break;
+    case 1:
+    case 5: sprintf(extra[i], "top.dut.blk%lu.nowhere%lu", i % 64, i); break;
+    case 2: sprintf(extra[i], "top.dut.noblk%lu.reg%lu", i % 16, i); break;
+    case 3:
+    case 7: sprintf(extra[i], "nowhere%lu", i); break;
+    case 4: sprintf(extra[i], "%s[99:64]", signals[i]); break;
+    case 6: sprintf(extra[i], "%s[0:15]", signals[i]); break;
+    }
+    paths[N_SIGNALS + i] = extra[i];
+  }
+
+  lookups = uvm_standin_num_lookups();
+  found = uvm_hdl_check_paths(&paths_a, &status_a, &widths_a);
+  lookups = uvm_standin_num_lookups() - lookups;
+
+  check(found == N_SIGNALS + N_EXTRA_PATHS / 8, "uvm_hdl_check_paths returns the paths found");
+  for (i = 0; i < N_CHECK_PATHS; i++) {
+    unsigned long sig = N_SIGNALS - 1 - i;
+    int exp_status = (i < N_SIGNALS || (i - N_SIGNALS) % 8 == 0);
+    int exp_width  = (i >= N_SIGNALS) ? 16 : (sig % 4 == 0) ? 64 : 32;
+    if (status[i] != exp_status || (exp_status && widths[i] != exp_width)) {
+      printf("UVM_ERROR: %s: status %d width %d\n", paths[i], status[i], widths[i]);
+      check(0, "uvm_hdl_check_paths status and widths");
+      break;
+    }
+    if (i < N_SIGNALS && uvm_hdl_check_path((char*) paths[i]) != 1) {
+      check(0, "uvm_hdl_check_paths agrees with uvm_hdl_check_path");
+      break;
+    }
+  }
+  // Each scope is looked up once, and the signals of the blocks are
+  // listed instead of being looked up
+  printf("UVM_PERF uvm_hdl_check_paths %lu lookups for %d paths\n", lookups, N_CHECK_PATHS);
+  check(lookups < N_CHECK_PATHS / 4, "uvm_hdl_check_paths lookups");
+
+  check(uvm_hdl_check_paths(&paths_a, &short_a, &widths_a) == -1,
+        "uvm_hdl_check_paths with a short status array");
+
+  n = n_ops(200);
+  start();
+  for (i = 0; i < n; i++)
+    sink += uvm_hdl_check_paths(&paths_a, &status_a, &widths_a);
+  stop("uvm_hdl_check_paths", n * N_CHECK_PATHS, 500000);
+}
+
+
+//--------------------------------------------------------------------
+// HDL injection scheduler
+//--------------------------------------------------------------------
+
+enum { INJ_DEPOSIT, INJ_FORCE, INJ_RELEASE, INJ_FLIP };
+enum { INJ_PENDING, INJ_ACTIVE, INJ_DONE };
+
+#define N_BATCH  N_SIGNALS
+
+static void bench_inject()
+{
+  // Batch elements are full UVM_HDL_MAX_WIDTH values, as passed from SV
+  static char *b_paths[N_BATCH];
+  static s_vpi_vecval b_vals[N_BATCH][32];
+  static unsigned long long b_starts[N_BATCH], b_durs[N_BATCH];
+  static int b_kinds[N_BATCH], b_ids[N_BATCH];
+  uvm_standin_array_t b_paths_a  = { b_paths, N_BATCH, sizeof(char*) };
+  uvm_standin_array_t b_vals_a   = { b_vals, N_BATCH, sizeof(b_vals[0]) };
+  uvm_standin_array_t b_starts_a = { b_starts, N_BATCH, sizeof(unsigned long long) };
+  uvm_standin_array_t b_durs_a   = { b_durs, N_BATCH, sizeof(unsigned long long) };
+  uvm_standin_array_t b_kinds_a  = { b_kinds, N_BATCH };
+  uvm_standin_array_t b_ids_a    = { b_ids, N_BATCH };
+  uvm_standin_array_t b_short_a  = { b_ids, N_BATCH - 1 };
+  unsigned long cb_handles = uvm_standin_num_cb_handles();
+  static unsigned int flips[N_SIGNALS];
+  static s_vpi_vecval init[N_SIGNALS];
+  s_vpi_vecval v[32], m[2], r[32];   // r is UVM_HDL_MAX_WIDTH bits
+  s_vpi_vecval full[2] = { { ~0u, 0 }, { ~0u, 0 } };
+  char *a = signals[10], *b = signals[12], *c = signals[13], *d = signals[14];
+  char *e = signals[15];
+  unsigned long long t0 = uvm_standin_time(), at, applied, released;
+  unsigned long i, n;
+  int id_a, id_b, id_d, ok;
+
+  v[0].aval = 0x11223344; v[0].bval = 0;
+  v[1].aval = 0x55667788; v[1].bval = 0;
+  uvm_hdl_deposit(b, v);
+
+  // Added out of order, the earliest injection is at t0+10
+  v[0].aval = 2;
+  uvm_hdl_inject_add(d, v, full, 90, 10, INJ_FORCE);
+  v[0].aval = 1;
+  id_d = uvm_hdl_inject_add(d, v, full, 80, 10, INJ_FORCE);
+  v[0].aval = 0x0F;
+  id_a = uvm_hdl_inject_add(a, v, full, 10, 0, INJ_DEPOSIT);
+  m[0].aval = 0x3; m[0].bval = 0;
+  uvm_hdl_inject_add(a, m, m, 20, 0, INJ_FLIP);
+  v[0].aval = 0xAB; v[1].aval = 0;
+  m[0].aval = 0xFF; m[1].aval = 0; m[1].bval = 0;
+  id_b = uvm_hdl_inject_add(b, v, m, 30, 15, INJ_FORCE);
+  v[0].aval = 0x77;
+  uvm_hdl_inject_add(c, v, full, 60, 0, INJ_FORCE);
+  uvm_hdl_inject_add(c, v, full, 70, 0, INJ_RELEASE);
+  check(uvm_hdl_inject_add((char*) "top.dut.nowhere", v, full, 10, 0, INJ_DEPOSIT) == -1,
+        "uvm_hdl_inject_add on a missing path");
+  check(uvm_hdl_inject_add(a, v, full, 10, 0, 7) == -1,
+        "uvm_hdl_inject_add of an invalid kind");
+  check(uvm_hdl_inject_num() == 7, "uvm_hdl_inject_num");
+
+  uvm_standin_run(t0 + 15);
+  uvm_hdl_read(a, r);
+  check(r[0].aval == 0x0F, "injected deposit");
+  check(uvm_hdl_inject_get(id_a, &at, &applied, &released, r) == INJ_DONE &&
+        at == t0 + 10 && applied == t0 + 10, "uvm_hdl_inject_get of a deposit");
+
+  // An injection earlier than the next scheduled one
+  v[0].aval = 0x99;
+  uvm_hdl_inject_add(e, v, full, 2, 0, INJ_DEPOSIT);
+  uvm_standin_run(t0 + 18);
+  uvm_hdl_read(e, r);
+  check(r[0].aval == 0x99, "injection added after the others");
+
+  uvm_standin_run(t0 + 25);
+  uvm_hdl_read(a, r);
+  check(r[0].aval == 0x0C, "injected bit flip");
+
+  uvm_standin_run(t0 + 40);
+  uvm_hdl_read(b, r);
+  check(uvm_standin_is_forced(b) && r[0].aval == 0x112233AB && r[1].aval == 0x55667788,
+        "masked timed force");
+  check(uvm_hdl_inject_get(id_b, &at, &applied, &released, r) == INJ_ACTIVE,
+        "timed force is active");
+  uvm_standin_run(t0 + 50);
+  check(!uvm_standin_is_forced(b), "timed force is released");
+  check(uvm_hdl_inject_get(id_b, &at, &applied, &released, r) == INJ_DONE &&
+        applied == t0 + 30 && released == t0 + 45 && r[0].aval == 0x112233AB,
+        "uvm_hdl_inject_get of a timed force");
+
+  uvm_standin_run(t0 + 65);
+  uvm_hdl_read(c, r);
+  check(uvm_standin_is_forced(c) && r[0].aval == 0x77, "injected force");
+  uvm_standin_run(t0 + 75);
+  check(!uvm_standin_is_forced(c), "injected release");
+
+  // Back-to-back forces: the first is released before the second applies
+  uvm_standin_run(t0 + 85);
+  uvm_hdl_read(d, r);
+  check(uvm_standin_is_forced(d) && r[0].aval == 1, "first back-to-back force");
+  uvm_standin_run(t0 + 95);
+  uvm_hdl_read(d, r);
+  check(uvm_standin_is_forced(d) && r[0].aval == 2, "second back-to-back force");
+  check(uvm_hdl_inject_get(id_d, &at, &applied, &released, r) == INJ_DONE &&
+        released == t0 + 90, "first back-to-back force is released");
+  uvm_standin_run(t0 + 105);
+  check(!uvm_standin_is_forced(d), "second back-to-back force is released");
+  check(uvm_hdl_inject_num_applied() == 8, "uvm_hdl_inject_num_applied");
+
+  // A campaign of timed bit flips, 4 per time unit
+  uvm_hdl_inject_clear();
+  check(uvm_hdl_inject_num() == 0, "uvm_hdl_inject_clear");
+  for (i = 0; i < N_SIGNALS; i++) {
+    uvm_hdl_read(signals[i], r);
+    init[i] = r[0];
+    flips[i] = 0;
+  }
+  for (i = 0; i < 32; i++) {
+    v[i].aval = 1u << i;
+    v[i].bval = 0;
+  }
+
+  n = n_ops(200000);
+  t0 = uvm_standin_time();
+  start();
+  for (i = 0; i < n; i++)
+    uvm_hdl_inject_add(signals[i % N_SIGNALS], &v[i % 32], &v[i % 32], 1 + i / 4, 3, INJ_FLIP);
+  stop("uvm_hdl_inject_add", n, 300000);
+
+  start();
+  uvm_standin_run(t0 + n / 4 + 10);
+  stop("uvm_hdl_inject_run", n, 300000);
+
+  for (i = 0; i < n; i++)
+    flips[i % N_SIGNALS] ^= 1u << (i % 32);
+  check(uvm_hdl_inject_num_applied() == (int) n, "all bit flips applied");
+  ok = 1;
+  for (i = 0; i < N_SIGNALS && ok; i++) {
+    uvm_hdl_read(signals[i], r);
+    ok = (r[0].aval == (init[i].aval ^ flips[i])) && !uvm_standin_is_forced(signals[i]);
+  }
+  check(ok, "bit flips applied and released");
+
+  // The same kind of campaign scheduled in one call; the last path is missing
+  uvm_hdl_inject_clear();
+  for (i = 0; i < N_SIGNALS; i++) {
+    uvm_hdl_read(signals[i], r);
+    init[i] = r[0];
+    flips[i] = 0;
+  }
+  for (i = 0; i < N_BATCH; i++) {
+    b_paths[i] = signals[(i * 7) % N_SIGNALS];
+    b_vals[i][0].aval = 1u << (i % 32);
+    b_starts[i] = 1 + i / 4;
+    b_durs[i] = 3;
+    b_kinds[i] = INJ_FLIP;
+  }
+  b_paths[N_BATCH - 1] = (char*) "top.dut.nowhere";
+  check(uvm_hdl_inject_add_batch(&b_paths_a, &b_vals_a, &b_vals_a, &b_starts_a,
+                                 &b_durs_a, &b_kinds_a, &b_short_a) == -1,
+        "uvm_hdl_inject_add_batch with a short ids array");
+
+  t0 = uvm_standin_time();
+  start();
+  n = uvm_hdl_inject_add_batch(&b_paths_a, &b_vals_a, &b_vals_a, &b_starts_a,
+                               &b_durs_a, &b_kinds_a, &b_ids_a);
+  stop("uvm_hdl_inject_add_batch", N_BATCH, 300000);
+  check(n == N_BATCH - 1 && b_ids[N_BATCH - 1] == -1 && b_ids[N_BATCH - 2] == N_BATCH - 2,
+        "uvm_hdl_inject_add_batch ids");
+
+  uvm_standin_run(t0 + N_BATCH / 4 + 10);
+  for (i = 0; i < N_BATCH - 1; i++)
+    flips[(i * 7) % N_SIGNALS] ^= 1u << (i % 32);
+  check(uvm_hdl_inject_num_applied() == N_BATCH - 1, "all batch bit flips applied");
+  ok = 1;
+  for (i = 0; i < N_SIGNALS && ok; i++) {
+    uvm_hdl_read(signals[i], r);
+    ok = (r[0].aval == (init[i].aval ^ flips[i])) && !uvm_standin_is_forced(signals[i]);
+  }
+  check(ok, "batch bit flips applied and released");
+  uvm_hdl_inject_clear();
+  check(uvm_standin_num_cb_handles() == cb_handles, "injection callback handles released");
+}
+
+
+//--------------------------------------------------------------------
+// Resource snapshots
+//--------------------------------------------------------------------
+
+static void put_u32(unsigned char *p, unsigned int v)
+{
+  p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+
+// Writes a snapshot holding a string record with id 'sid' and a
+// resource record of 'num_words' words, 'stored' of them stored
+static void write_snap(const char *file, unsigned int sid,
+                       unsigned int num_words, unsigned int stored)
+{
+  unsigned char buf[16 + 10 + 5 + 32 + 4 * 4];
+  unsigned int len = 16;
+  FILE *fp;
+
+  memset(buf, 0, sizeof(buf));
+  memcpy(buf, "UVMRSNP", 8);
+  put_u32(buf + 8, 1);
+  buf[len] = 1;                  // STR "x"
+  put_u32(buf + len + 1, 5);
+  put_u32(buf + len + 5, sid);
+  buf[len + 9] = 'x';
+  len += 10;
+  buf[len] = 2;                  // RSRC named "x"
+  put_u32(buf + len + 1, 32 + 4 * stored);
+  put_u32(buf + len + 5 + 28, num_words);
+  len += 5 + 32 + 4 * stored;
+  fp = fopen(file, "wb");
+  fwrite(buf, 1, len, fp);
+  fclose(fp);
+}
+
+
+static void bench_rsrc_snap()
+{
+  const char *file = "uvm_dpi_bench_snap.bin";
+  unsigned long i, n;
+  unsigned int w[4];
+  uvm_standin_array_t words = { w, 4 };
+  const char *name, *scope, *tag;
+  unsigned int prec;
+  int flags, name_pos, type_pos, num_words, ok = 1;
+
+  // Small values, as most configuration values are
+  n = n_ops(200000);
+  start();
+  check(uvm_rsrc_snap_create(file), "snapshot created");
+  for (i = 0; i < n; i++) {
+    if (i & 1)
+      w[0] = (unsigned int) i;
+    else {
+      w[0] = 0; w[1] = 0; w[2] = i >> 16; w[3] = (unsigned int) i;
+    }
+    uvm_rsrc_snap_put(signals[i % N_SIGNALS] + 4, signals[(i / 7) % N_SIGNALS],
+                      (i & 1) ? "int" : "uvm_bitstream_t", 1000 - (i % 3),
+                      i % 5, i / N_SIGNALS, i, &words, (i & 1) ? 1 : 4);
+  }
+  check(uvm_rsrc_snap_close(), "snapshot written");
+  stop("uvm_rsrc_snap_put", n, 1000000);
+
+  start();
+  check(uvm_rsrc_snap_open(file) == (int) n, "snapshot resource count");
+  for (i = 0; i < n && ok; i++) {
+    if (!uvm_rsrc_snap_next(&name, &scope, &tag, &prec, &flags,
+                            &name_pos, &type_pos, &num_words)) {
+      ok = 0;
+      break;
+    }
+    memset(w, 0xff, sizeof(w));
+    words.size = num_words;
+    uvm_rsrc_snap_get_words(&words);
+    if (strcmp(name, signals[i % N_SIGNALS] + 4) != 0 ||
+        strcmp(scope, signals[(i / 7) % N_SIGNALS]) != 0 ||
+        strcmp(tag, (i & 1) ? "int" : "uvm_bitstream_t") != 0 ||
+        prec != 1000 - (i % 3) || flags != (int) (i % 5) ||
+        name_pos != (int) (i / N_SIGNALS) || type_pos != (int) i)
+      ok = 0;
+    else if (i & 1)
+      ok = (num_words == 1 && w[0] == (unsigned int) i);
+    else
+      ok = (num_words == 4 && w[0] == 0 && w[1] == 0 &&
+            w[2] == i >> 16 && w[3] == (unsigned int) i);
+  }
+  check(ok, "snapshot resources read back");
+  check(!uvm_rsrc_snap_next(&name, &scope, &tag, &prec, &flags,
+                            &name_pos, &type_pos, &num_words), "snapshot end");
+  uvm_rsrc_snap_close();
+  stop("uvm_rsrc_snap_next", n, 1000000);
+
+  // Corrupted string ids and value sizes are rejected by open
+  write_snap(file, 0, 3, 2);
+  check(uvm_rsrc_snap_open(file) == 1 &&
+        uvm_rsrc_snap_next(&name, &scope, &tag, &prec, &flags,
+                           &name_pos, &type_pos, &num_words) &&
+        strcmp(name, "x") == 0 && num_words == 3, "handmade snapshot");
+  uvm_rsrc_snap_close();
+  write_snap(file, 0xffffffffu, 3, 2);
+  check(uvm_rsrc_snap_open(file) == -1, "snapshot with a string id out of range");
+  write_snap(file, 0, 0x80000000u, 2);
+  check(uvm_rsrc_snap_open(file) == -1, "snapshot with a huge value");
+  write_snap(file, 0, 1, 2);
+  check(uvm_rsrc_snap_open(file) == -1, "snapshot with more words stored than its value has");
+  remove(file);
+}
+
+
+//--------------------------------------------------------------------
+// Reference model pools
+//--------------------------------------------------------------------
+
+#define REFMODEL_FAIL 0xdeadbeefu
+
+// Stands for a costly reference model: each input word goes through
+// 'rounds' of mixing, after a header word holding the input size
+static int bench_model(void *ctx, const unsigned int *in, int n_in,
+                       unsigned int *out, int max_out)
+{
+  int rounds = *(int*) ctx;
+  int i, r;
+
+  if (n_in + 1 > max_out || (n_in > 0 && in[0] == REFMODEL_FAIL))
+    return -1;
+  out[0] = (unsigned int) n_in;
+  for (i = 0; i < n_in; i++) {
+    unsigned int x = in[i];
+    for (r = 0; r < rounds; r++) {
+      x = x * 1664525u + 1013904223u;
+      x ^= x >> 13;
+    }
+    out[i + 1] = x;
+  }
+  return n_in + 1;
+}
+
+
+static void bench_refmodel()
+{
+  static int rounds = 2000;
+  unsigned int in[8], out[64 * 9], expect[9];
+  unsigned int *all_out;
+  int lens[64], *all_lens;
+  uvm_standin_array_t in_a = { in, 8 }, out_a = { out, 64 * 9 }, lens_a = { lens, 64 };
+  unsigned long i, n, sent, got, pos, all_pos;
+  int h, k, j, ok = 1;
+
+  check(uvm_refmodel_pool_new("bench_none", 0, 9) == -1, "pool of an unregistered model");
+  check(uvm_refmodel_register("bench_mix", bench_model, &rounds), "model registered");
+
+  h = uvm_refmodel_pool_new("bench_mix", 0, 9);
+  check(h >= 0 && uvm_refmodel_num_threads(h) > 0, "pool with one thread per processor");
+  if (h < 0)
+    return;
+
+  // Items of 1 to 8 words, the 100th fails. Results are collected in
+  // order while newer items are being transformed.
+  n = n_ops(20000);
+  all_out = (unsigned int*) malloc(n * 9 * sizeof(unsigned int));
+  all_lens = (int*) malloc(n * sizeof(int));
+  sent = got = all_pos = 0;
+  start();
+  while (got < n) {
+    while (sent < n && sent - got < 256) {
+      int n_in = (int) (sent % 8) + 1;
+      for (j = 0; j < n_in; j++)
+        in[j] = (unsigned int) (sent * 8 + j);
+      if (sent == 100)
+        in[0] = REFMODEL_FAIL;
+      if (!uvm_refmodel_submit(h, &in_a, n_in)) {
+        check(0, "uvm_refmodel_submit");
+        return;
+      }
+      sent++;
+    }
+    k = uvm_refmodel_collect(h, &out_a, &lens_a, 64);
+    if (k == 0) {
+      check(0, "uvm_refmodel_collect");
+      return;
+    }
+    for (pos = 0, j = 0; j < k; j++, got++) {
+      all_lens[got] = lens[j];
+      if (lens[j] > 0) {
+        memcpy(all_out + all_pos, out + pos, lens[j] * sizeof(unsigned int));
+        pos += lens[j];
+        all_pos += lens[j];
+      }
+    }
+  }
+  stop("uvm_refmodel_pipeline", n, 10000);
+
+  for (got = 0, all_pos = 0; got < n && ok; got++) {
+    int n_in = (int) (got % 8) + 1;
+    if (got == 100) {
+      ok = (all_lens[got] == -1);
+      continue;
+    }
+    for (i = 0; i < (unsigned long) n_in; i++)
+      in[i] = (unsigned int) (got * 8 + i);
+    bench_model(&rounds, in, n_in, expect, 9);
+    ok = (all_lens[got] == n_in + 1) &&
+         memcmp(all_out + all_pos, expect, (n_in + 1) * sizeof(unsigned int)) == 0;
+    all_pos += n_in + 1;
+  }
+  check(ok, "reference model results collected in order");
+  free(all_out);
+  free(all_lens);
+  check(uvm_refmodel_pending(h) == 0, "no item pending");
+
+  // Collection stops when the result array is full
+  for (i = 0; i < 4; i++) {
+    in[0] = (unsigned int) i;
+    uvm_refmodel_submit(h, &in_a, 8);
+  }
+  out_a.size = 20;
+  check(uvm_refmodel_collect(h, &out_a, &lens_a, 4) == 2 &&
+        uvm_refmodel_pending(h) == 2, "collection into a small array");
+  out_a.size = 64 * 9;
+
+  // Pending items are discarded
+  uvm_refmodel_pool_free(h);
+}
+
+
+//--------------------------------------------------------------------
+// DPI profile
+//--------------------------------------------------------------------
+
+static void bench_profile()
+{
+  unsigned long i, n;
+  unsigned long long sum = 0;
+  int id, match = -1, b;
+  volatile int sink = 0;
+  const char *re = "/^top\\.env\\..*$/";
+
+  for (id = 0; id < uvm_dpi_profile_num(); id++)
+    if (strcmp(uvm_dpi_profile_name(id), "uvm_re_match") == 0)
+      match = id;
+  check(match >= 0, "uvm_re_match is profiled");
+  if (match < 0)
+    return;
+
+  // Everything so far ran with the profile disabled
+  check(uvm_dpi_profile_calls(match) == 0, "no calls counted while disabled");
+
+  uvm_dpi_profile_enable(1);
+  n = n_ops(500000);
+  start();
+  for (i = 0; i < n; i++)
+    sink += uvm_re_match(re, signals[i % N_SIGNALS]);
+  stop("uvm_re_match_cached_profiled", n, 150000);
+  uvm_dpi_profile_enable(0);
+
+  check(uvm_dpi_profile_calls(match) == n, "uvm_re_match calls counted");
+  for (b = 0; b < uvm_dpi_profile_num_buckets(); b++)
+    sum += uvm_dpi_profile_bucket(match, b);
+  check(sum == n, "uvm_re_match histogram adds up");
+  uvm_dpi_profile_reset();
+}
+
+
+int main(int argc, char **argv)
+{
+  int i;
+
+  for (i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-v") == 0)
+      uvm_standin_set_verbose(1);
+    else if (strcmp(argv[i], "-scale") == 0 && i + 1 < argc)
+      scale = atof(argv[++i]) / 100.0;
+    else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+      iters = atof(argv[++i]) / 100.0;
+    else {
+      fprintf(stderr, "usage: uvm_dpi_bench [-v] [-scale <percent>] [-n <percent>]\n");
+      return 2;
+    }
+  }
+
+  uvm_standin_add_signal("uvm_pkg::UVM_HDL_MAX_WIDTH", 32);
+  {
+    s_vpi_vecval w = { 1024, 0 };
+    s_vpi_value  value;
+    value.format = vpiVectorVal;
+    value.value.vector = &w;
+    vpi_put_value(vpi_handle_by_name((PLI_BYTE8*) "uvm_pkg::UVM_HDL_MAX_WIDTH", NULL),
+                  &value, NULL, vpiNoDelay);
+  }
+
+  bench_regex();
+  bench_cmdline();
+  bench_hdl();
+  bench_hdl_check_paths();
+  bench_inject();
+  bench_rsrc_snap();
+  bench_refmodel();
+  bench_profile();
+
+  // Only the expected failures of the missing paths, of the short
+  // status and injection ids arrays, of the invalid injection kind, of
+  // the corrupted snapshots and of the unregistered reference model
+  if (uvm_standin_num_errors() != 10) {
+    printf("UVM_ERROR: %lu errors reported by the DPI code\n", uvm_standin_num_errors());
+    n_fails++;
+  }
+
+  if (n_fails == 0)
+    printf("** UVM TEST PASSED **\n");
+  else
+    printf("!! UVM TEST FAILED !!\n");
+  return n_fails != 0;
+}
@@ -0,0 +1,640 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+/*
+ * In-memory VPI/svdpi stand-in.
+ *
+ * Provides the VPI and svdpi routines referenced by distrib/src/dpi
+ * on top of a hashed table of signals, so the UVM DPI code can be
+ * linked and exercised without a simulator. The scopes of the signals,
+ * i.e. what precedes the last '.' of their name, are modules that
+ * list their signals for vpi_iterate. Forcing follows the
+ * simulator semantics that matter to uvm_hdl: a deposit on a forced
+ * signal does not change its value, and a release leaves the forced
+ * value in place until the next deposit. Time only advances in
+ * uvm_standin_run, which runs the time and read-write synchronization
+ * callbacks in order.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vpi_user.h"
+#include "veriuser.h"
+#include "svdpi.h"
+#include "uvm_dpi_standin.h"
+
+
+struct uvm_standin_obj_s {
+  char          *name;
+  unsigned int   hash;
+  PLI_INT32      type;      // vpiReg, vpiModule, vpiIterator or vpiConstant
+  const char    *leaf;      // vpiName
+  int            size;
+  int            forced;
+  s_vpi_vecval  *val;
+
+  // Signals of a module, or listed by an iterator
+  struct uvm_standin_obj_s **sigs;
+  int            num_sigs;
+  int            max_sigs;
+  int            pos;       // next signal scanned by an iterator
+
+  // Callbacks
+  PLI_INT32    (*cb_rtn)(struct t_cb_data *);
+  PLI_INT32      reason;
+  unsigned long long at;
+  PLI_BYTE8     *user_data;
+  int            pending;
+  int            released;
+};
+
+static struct uvm_standin_obj_s **uvm_standin_objs = NULL;
+static unsigned int uvm_standin_objs_size = 0;   // power of 2
+static unsigned int uvm_standin_objs_used = 0;
+
+static char **uvm_standin_argv = NULL;
+static int uvm_standin_argc = 0;
+static int uvm_standin_verbose = 0;
+static unsigned long uvm_standin_errors = 0;
+static unsigned long uvm_standin_lookups = 0;
+
+static unsigned long long uvm_standin_now = 0;
+static struct uvm_standin_obj_s **uvm_standin_cbs = NULL;
+static int uvm_standin_num_cbs = 0;
+static int uvm_standin_max_cbs = 0;
+static unsigned long uvm_standin_cb_handles = 0;
+
+
+static unsigned int uvm_standin_hash(const char *s)
+{
+  unsigned int h = 2166136261u;
+  while (*s) {
+    h ^= (unsigned char)*s++;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+
+static void uvm_standin_grow()
+{
+  struct uvm_standin_obj_s **old = uvm_standin_objs;
+  unsigned int old_size = uvm_standin_objs_size;
+  unsigned int i;
+
+  uvm_standin_objs_size = (old_size == 0) ? 1024 : 2 * old_size;
+  uvm_standin_objs = (struct uvm_standin_obj_s**)
+    calloc(uvm_standin_objs_size, sizeof(struct uvm_standin_obj_s*));
+  for (i = 0; i < old_size; i++) {
+    unsigned int j;
+    if (old[i] == NULL)
+      continue;
+    j = old[i]->hash & (uvm_standin_objs_size - 1);
+    while (uvm_standin_objs[j] != NULL)
+      j = (j + 1) & (uvm_standin_objs_size - 1);
+    uvm_standin_objs[j] = old[i];
+  }
+  free(old);
+}
+
+
+static struct uvm_standin_obj_s *uvm_standin_find(const char *name)
+{
+  unsigned int h, j;
+
+  if (uvm_standin_objs_size == 0)
+    return NULL;
+  h = uvm_standin_hash(name);
+  j = h & (uvm_standin_objs_size - 1);
+  while (uvm_standin_objs[j] != NULL) {
+    if (uvm_standin_objs[j]->hash == h && strcmp(uvm_standin_objs[j]->name, name) == 0)
+      return uvm_standin_objs[j];
+    j = (j + 1) & (uvm_standin_objs_size - 1);
+  }
+  return NULL;
+}
+
+
+static void uvm_standin_add_sig(struct uvm_standin_obj_s *scope, struct uvm_standin_obj_s *obj)
+{
+  if (scope->num_sigs == scope->max_sigs) {
+    scope->max_sigs = (scope->max_sigs == 0) ? 16 : 2 * scope->max_sigs;
+    scope->sigs = (struct uvm_standin_obj_s**)
+      realloc(scope->sigs, scope->max_sigs * sizeof(struct uvm_standin_obj_s*));
+  }
+  scope->sigs[scope->num_sigs++] = obj;
+}
+
+
+// Adds an object, and the modules of its scope if they do not exist
+static struct uvm_standin_obj_s *uvm_standin_add(const char *name, PLI_INT32 type, int size)
+{
+  struct uvm_standin_obj_s *obj, *scope = NULL;
+  int depth = 0, dot = -1, i;
+  unsigned int j;
+
+  for (i = 0; name[i] != '\0'; i++) {
+    if (name[i] == '[')
+      depth++;
+    else if (name[i] == ']')
+      depth--;
+    else if (name[i] == '.' && depth == 0)
+      dot = i;
+  }
+  if (dot > 0) {
+    char *scope_name = (char*) malloc(dot + 1);
+    memcpy(scope_name, name, dot);
+    scope_name[dot] = '\0';
+    scope = uvm_standin_find(scope_name);
+    if (scope == NULL)
+      scope = uvm_standin_add(scope_name, vpiModule, 0);
+    free(scope_name);
+  }
+
+  if (2 * (uvm_standin_objs_used + 1) > uvm_standin_objs_size)
+    uvm_standin_grow();
+
+  obj = (struct uvm_standin_obj_s*) calloc(1, sizeof(struct uvm_standin_obj_s));
+  obj->name = (char*) malloc(strlen(name) + 1);
+  strcpy(obj->name, name);
+  obj->hash = uvm_standin_hash(name);
+  obj->type = type;
+  obj->leaf = obj->name + dot + 1;
+  obj->size = size;
+  if (type != vpiModule)
+    obj->val = (s_vpi_vecval*) calloc((size - 1) / 32 + 1, sizeof(s_vpi_vecval));
+
+  j = obj->hash & (uvm_standin_objs_size - 1);
+  while (uvm_standin_objs[j] != NULL)
+    j = (j + 1) & (uvm_standin_objs_size - 1);
+  uvm_standin_objs[j] = obj;
+  uvm_standin_objs_used++;
+  if (scope != NULL)
+    uvm_standin_add_sig(scope, obj);
+  return obj;
+}
+
+
+vpiHandle uvm_standin_add_signal(const char *name, int size)
+{
+  return uvm_standin_add(name, vpiReg, size);
+}
+
+
+int uvm_standin_is_forced(const char *name)
+{
+  vpiHandle obj = vpi_handle_by_name((PLI_BYTE8*) name, NULL);
+  return obj != NULL && obj->forced;
+}
+
+
+unsigned long long uvm_standin_time()
+{
+  return uvm_standin_now;
+}
+
+
+static void uvm_standin_fire(int i)
+{
+  struct uvm_standin_obj_s *cb = uvm_standin_cbs[i];
+  s_cb_data cb_s;
+  s_vpi_time time_s;
+
+  uvm_standin_cbs[i] = uvm_standin_cbs[--uvm_standin_num_cbs];
+  time_s.type = vpiSimTime;
+  time_s.high = (PLI_UINT32) (uvm_standin_now >> 32);
+  time_s.low  = (PLI_UINT32) uvm_standin_now;
+  time_s.real = 0.0;
+  memset(&cb_s, 0, sizeof(cb_s));
+  cb_s.reason    = cb->reason;
+  cb_s.cb_rtn    = cb->cb_rtn;
+  cb_s.time      = &time_s;
+  cb_s.user_data = cb->user_data;
+  cb_s.cb_rtn(&cb_s);
+  // As with a simulator, the handle stays valid until it is released,
+  // which the routine itself may do
+  cb->pending = 0;
+  if (cb->released) {
+    free(cb);
+    uvm_standin_cb_handles--;
+  }
+}
+
+
+unsigned long uvm_standin_run(unsigned long long until)
+{
+  unsigned long n = 0;
+  int i, next;
+
+  for (;;) {
+    next = -1;
+    for (i = 0; i < uvm_standin_num_cbs; i++) {
+      struct uvm_standin_obj_s *cb = uvm_standin_cbs[i];
+      if (cb->reason == cbReadWriteSynch) {
+        if (next < 0)
+          next = i;
+      }
+      else if (cb->at <= uvm_standin_now) {
+        next = i;
+        break;
+      }
+    }
+    if (next < 0) {
+      for (i = 0; i < uvm_standin_num_cbs; i++)
+        if (next < 0 || uvm_standin_cbs[i]->at < uvm_standin_cbs[next]->at)
+          next = i;
+      if (next < 0 || uvm_standin_cbs[next]->at > until)
+        break;
+      uvm_standin_now = uvm_standin_cbs[next]->at;
+    }
+    uvm_standin_fire(next);
+    n++;
+  }
+  if (until > uvm_standin_now)
+    uvm_standin_now = until;
+  return n;
+}
+
+
+void uvm_standin_set_argv(int argc, char **argv)
+{
+  uvm_standin_argc = argc;
+  uvm_standin_argv = argv;
+}
+
+
+void uvm_standin_set_verbose(int verbose)
+{
+  uvm_standin_verbose = verbose;
+}
+
+
+unsigned long uvm_standin_num_errors()
+{
+  return uvm_standin_errors;
+}
+
+
+unsigned long uvm_standin_num_lookups()
+{
+  return uvm_standin_lookups;
+}
+
+
+unsigned long uvm_standin_num_cb_handles()
+{
+  return uvm_standin_cb_handles;
+}
+
+
+//--------------------------------------------------------------------
+// VPI
+//--------------------------------------------------------------------
+
+PLI_INT32 vpi_printf(PLI_BYTE8 *format, ...)
+{
+  va_list ap;
+  int n = 0;
+
+  if (strncmp(format, "UVM_ERROR", 9) == 0)
+    uvm_standin_errors++;
+  if (uvm_standin_verbose) {
+    va_start(ap, format);
+    n = vprintf(format, ap);
+    va_end(ap);
+  }
+  return n;
+}
+
+
+vpiHandle vpi_handle_by_name(PLI_BYTE8 *name, vpiHandle scope)
+{
+  char buf[256], *full;
+  vpiHandle obj;
+  size_t len;
+
+  if (name == NULL)
+    return NULL;
+  uvm_standin_lookups++;
+  if (scope == NULL)
+    return uvm_standin_find(name);
+
+  // Relative to a module
+  if (scope->type != vpiModule)
+    return NULL;
+  len = strlen(scope->name) + 1 + strlen(name) + 1;
+  full = (len <= sizeof(buf)) ? buf : (char*) malloc(len);
+  strcpy(full, scope->name);
+  strcat(full, ".");
+  strcat(full, name);
+  obj = uvm_standin_find(full);
+  if (full != buf)
+    free(full);
+  return obj;
+}
+
+
+// The range of a signal of N bits is [N-1:0]
+
+vpiHandle vpi_handle(PLI_INT32 type, vpiHandle refHandle)
+{
+  struct uvm_standin_obj_s *c;
+
+  if (refHandle == NULL || refHandle->type != vpiReg ||
+      (type != vpiLeftRange && type != vpiRightRange))
+    return NULL;
+  c = (struct uvm_standin_obj_s*) calloc(1, sizeof(struct uvm_standin_obj_s));
+  c->type = vpiConstant;
+  c->size = 32;
+  c->val = (s_vpi_vecval*) calloc(1, sizeof(s_vpi_vecval));
+  c->val[0].aval = (type == vpiLeftRange) ? refHandle->size - 1 : 0;
+  return c;
+}
+
+
+PLI_INT32 vpi_get(PLI_INT32 property, vpiHandle object)
+{
+  if (object == NULL)
+    return 0;
+  if (property == vpiSize)
+    return object->size;
+  if (property == vpiType)
+    return object->type;
+  return 0;
+}
+
+
+PLI_BYTE8 *vpi_get_str(PLI_INT32 property, vpiHandle object)
+{
+  if (object == NULL || object->type == vpiIterator)
+    return NULL;
+  if (property == vpiName)
+    return (PLI_BYTE8*) object->leaf;
+  if (property == vpiFullName)
+    return object->name;
+  return NULL;
+}
+
+
+vpiHandle vpi_iterate(PLI_INT32 type, vpiHandle refHandle)
+{
+  struct uvm_standin_obj_s *it;
+  int i;
+
+  if (refHandle == NULL || refHandle->type != vpiModule)
+    return NULL;
+  it = (struct uvm_standin_obj_s*) calloc(1, sizeof(struct uvm_standin_obj_s));
+  it->type = vpiIterator;
+  for (i = 0; i < refHandle->num_sigs; i++)
+    if (refHandle->sigs[i]->type == type)
+      uvm_standin_add_sig(it, refHandle->sigs[i]);
+  if (it->num_sigs == 0) {
+    free(it);
+    return NULL;
+  }
+  return it;
+}
+
+
+vpiHandle vpi_scan(vpiHandle iterator)
+{
+  if (iterator == NULL || iterator->type != vpiIterator)
+    return NULL;
+  // The iterator is freed once all its objects are scanned
+  if (iterator->pos == iterator->num_sigs) {
+    free(iterator->sigs);
+    free(iterator);
+    return NULL;
+  }
+  return iterator->sigs[iterator->pos++];
+}
+
+
+void vpi_get_value(vpiHandle expr, p_vpi_value value_p)
+{
+  if (expr == NULL || value_p == NULL || expr->val == NULL)
+    return;
+  if (value_p->format == vpiIntVal)
+    value_p->value.integer = (PLI_INT32) expr->val[0].aval;
+  else if (value_p->format == vpiVectorVal)
+    value_p->value.vector = expr->val;   // valid until the next change
+}
+
+
+vpiHandle vpi_put_value(vpiHandle object, p_vpi_value value_p,
+                        p_vpi_time time_p, PLI_INT32 flags)
+{
+  int words, i;
+
+  if (object == NULL || object->val == NULL || value_p == NULL ||
+      value_p->format != vpiVectorVal)
+    return NULL;
+  words = (object->size - 1) / 32 + 1;
+
+  if (flags == vpiReleaseFlag) {
+    object->forced = 0;
+    if (value_p->value.vector != NULL)
+      for (i = 0; i < words; i++)
+        value_p->value.vector[i] = object->val[i];
+    return NULL;
+  }
+  if (object->forced && flags != vpiForceFlag)
+    return NULL;
+  if (flags == vpiForceFlag)
+    object->forced = 1;
+  for (i = 0; i < words; i++)
+    object->val[i] = value_p->value.vector[i];
+  if (object->size % 32) {
+    object->val[words-1].aval &= (1u << (object->size % 32)) - 1;
+    object->val[words-1].bval &= (1u << (object->size % 32)) - 1;
+  }
+  return NULL;
+}
+
+
+PLI_INT32 vpi_get_vlog_info(p_vpi_vlog_info vlog_info_p)
+{
+  static char empty_argv0[] = "";
+  static char *empty_argv[] = { empty_argv0, NULL };
+
+  vlog_info_p->argc    = uvm_standin_argv ? uvm_standin_argc : 1;
+  vlog_info_p->argv    = uvm_standin_argv ? uvm_standin_argv : empty_argv;
+  vlog_info_p->product = (PLI_BYTE8*) "uvm_dpi_standin";
+  vlog_info_p->version = (PLI_BYTE8*) "1.0";
+  return 1;
+}
+
+
+PLI_INT32 vpi_release_handle(vpiHandle object)
+{
+  // Handles are the objects themselves, except for the iterators,
+  // the range constants and the callbacks, which are freed once
+  // released and no longer pending
+  if (object != NULL && object->type == vpiIterator) {
+    free(object->sigs);
+    free(object);
+  }
+  else if (object != NULL && object->type == vpiConstant) {
+    free(object->val);
+    free(object);
+  }
+  else if (object != NULL && object->type == vpiCallback) {
+    if (object->released) {
+      vpi_printf((PLI_BYTE8*) "UVM_ERROR: vpi_release_handle: callback handle released twice\n");
+      return 0;
+    }
+    object->released = 1;
+    if (!object->pending) {
+      free(object);
+      uvm_standin_cb_handles--;
+    }
+  }
+  return 1;
+}
+
+
+void vpi_get_time(vpiHandle object, p_vpi_time time_p)
+{
+  time_p->high = (PLI_UINT32) (uvm_standin_now >> 32);
+  time_p->low  = (PLI_UINT32) uvm_standin_now;
+  time_p->real = (double) uvm_standin_now;
+}
+
+
+vpiHandle vpi_register_cb(p_cb_data cb_data_p)
+{
+  struct uvm_standin_obj_s *cb;
+  unsigned long long t = 0;
+
+  if (cb_data_p->reason != cbAtStartOfSimTime && cb_data_p->reason != cbAfterDelay &&
+      cb_data_p->reason != cbReadWriteSynch)
+    return NULL;
+  if (cb_data_p->time != NULL)
+    t = ((unsigned long long) cb_data_p->time->high << 32) | cb_data_p->time->low;
+
+  cb = (struct uvm_standin_obj_s*) calloc(1, sizeof(struct uvm_standin_obj_s));
+  cb->type      = vpiCallback;
+  cb->pending   = 1;
+  cb->reason    = cb_data_p->reason;
+  cb->cb_rtn    = cb_data_p->cb_rtn;
+  cb->user_data = cb_data_p->user_data;
+  // cbAtStartOfSimTime is at an absolute time, cbAfterDelay after a delay
+  if (cb->reason == cbAtStartOfSimTime)
+    cb->at = t;
+  else if (cb->reason == cbAfterDelay)
+    cb->at = uvm_standin_now + t;
+  else
+    cb->at = uvm_standin_now;
+
+  if (uvm_standin_num_cbs == uvm_standin_max_cbs) {
+    uvm_standin_max_cbs = (uvm_standin_max_cbs == 0) ? 16 : 2 * uvm_standin_max_cbs;
+    uvm_standin_cbs = (struct uvm_standin_obj_s**)
+      realloc(uvm_standin_cbs, uvm_standin_max_cbs * sizeof(struct uvm_standin_obj_s*));
+  }
+  uvm_standin_cbs[uvm_standin_num_cbs++] = cb;
+  uvm_standin_cb_handles++;
+  return cb;
+}
+
+
+PLI_INT32 vpi_remove_cb(vpiHandle cb_obj)
+{
+  int i;
+  for (i = 0; i < uvm_standin_num_cbs; i++)
+    if (uvm_standin_cbs[i] == cb_obj) {
+      uvm_standin_cbs[i] = uvm_standin_cbs[--uvm_standin_num_cbs];
+      free(cb_obj);
+      uvm_standin_cb_handles--;
+      return 1;
+    }
+  vpi_printf((PLI_BYTE8*) "UVM_ERROR: vpi_remove_cb: not a pending callback\n");
+  return 0;
+}
+
+
+int tf_dofinish()
+{
+  exit(1);
+  return 0;
+}
+
+
+//--------------------------------------------------------------------
+// svdpi
+//--------------------------------------------------------------------
+
+void *svGetArrayPtr(const svOpenArrayHandle h)
+{
+  return h->data;
+}
+
+
+void *svGetArrElemPtr1(const svOpenArrayHandle h, int indx1)
+{
+  if (indx1 < 0 || indx1 >= h->size)
+    return NULL;
+  return (char*) h->data + indx1 * (h->elem_size ? h->elem_size : sizeof(unsigned int));
+}
+
+
+int svSize(const svOpenArrayHandle h, int d)
+{
+  return (d == 1) ? h->size : 0;
+}
+
+
+int svLow(const svOpenArrayHandle h, int d)
+{
+  return 0;
+}
+
+
+svLogic svGetBitselLogic(const svLogicVecVal *s, int i)
+{
+  PLI_UINT32 a = (s[i/32].aval >> (i%32)) & 1;
+  PLI_UINT32 b = (s[i/32].bval >> (i%32)) & 1;
+  return (svLogic) ((b << 1) | a);
+}
+
+
+void svGetPartselLogic(svLogicVecVal *d, const svLogicVecVal *s, int i, int w)
+{
+  int k;
+  for (k = 0; k < (w - 1) / 32 + 1; k++)
+    d[k].aval = d[k].bval = 0;
+  for (k = 0; k < w; k++) {
+    svLogic b = svGetBitselLogic(s, i + k);
+    d[k/32].aval |= (PLI_UINT32) (b & 1) << (k%32);
+    d[k/32].bval |= (PLI_UINT32) (b >> 1) << (k%32);
+  }
+}
+
+
+void svPutPartselLogic(svLogicVecVal *d, const svLogicVecVal s, int i, int w)
+{
+  int k;
+  for (k = 0; k < w && k < 32; k++) {
+    PLI_UINT32 m = 1u << ((i + k) % 32);
+    svLogicVecVal *p = &d[(i + k) / 32];
+    p->aval = (p->aval & ~m) | (((s.aval >> k) & 1) ? m : 0);
+    p->bval = (p->bval & ~m) | (((s.bval >> k) & 1) ? m : 0);
+  }
+}
@@ -0,0 +1,71 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+/*
+ * Harness-side interface of the in-memory VPI/svdpi stand-in
+ * (uvm_dpi_standin.c).
+ */
+
+#ifndef UVM_DPI_STANDIN_H
+#define UVM_DPI_STANDIN_H
+
+#include "vpi_user.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Adds a signal of 'size' bits, initially 0, to the fake hierarchy,
+// and the modules of its scope
+vpiHandle uvm_standin_add_signal(const char *name, int size);
+
+// Returns 1 if the named signal is currently forced
+int uvm_standin_is_forced(const char *name);
+
+// Current simulation time
+unsigned long long uvm_standin_time();
+
+// Advances the simulation time up to 'until', running the callbacks
+// registered with vpi_register_cb: at each time, the cbAtStartOfSimTime
+// and cbAfterDelay callbacks, then the cbReadWriteSynch callbacks until
+// none is left. Returns the number of callbacks run.
+unsigned long uvm_standin_run(unsigned long long until);
+
+// Sets the command line returned by vpi_get_vlog_info.
+// 'argv' must be NULL-terminated and outlive its use.
+void uvm_standin_set_argv(int argc, char **argv);
+
+// Messages printed with vpi_printf are only counted unless 'verbose'
+void uvm_standin_set_verbose(int verbose);
+
+// Number of vpi_printf messages starting with "UVM_ERROR"
+unsigned long uvm_standin_num_errors();
+
+// Number of vpi_handle_by_name calls
+unsigned long uvm_standin_num_lookups();
+
+// Number of callback handles neither removed nor released, whether
+// the callback is pending or has run
+unsigned long uvm_standin_num_cb_handles();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,37 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+/*
+ * In-memory stand-in for veriuser.h, see vpi_user.h
+ */
+
+#ifndef VERIUSER_H
+#define VERIUSER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int tf_dofinish();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,127 @@
+//----------------------------------------------------------------------
+//   Copyright 2011 Cadence Design Systems, Inc.
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+/*
+ * In-memory stand-in for the subset of the IEEE 1800 VPI used by the
+ * UVM DPI code, for the native benchmark harness (uvm_dpi_bench.cc).
+ * It is NOT a complete vpi_user.h: only the types, constants and
+ * routines referenced in distrib/src/dpi are provided.
+ */
+
+#ifndef VPI_USER_H
+#define VPI_USER_H
+
+typedef int          PLI_INT32;
+typedef unsigned int PLI_UINT32;
+typedef char         PLI_BYTE8;
+
+typedef struct uvm_standin_obj_s *vpiHandle;
+
+typedef struct t_vpi_vecval {
+  PLI_UINT32 aval, bval;
+} s_vpi_vecval, *p_vpi_vecval;
+
+typedef struct t_vpi_time {
+  PLI_INT32  type;
+  PLI_UINT32 high, low;
+  double     real;
+} s_vpi_time, *p_vpi_time;
+
+typedef struct t_vpi_value {
+  PLI_INT32 format;
+  union {
+    PLI_BYTE8           *str;
+    PLI_INT32            scalar;
+    PLI_INT32            integer;
+    double               real;
+    struct t_vpi_time   *time;
+    struct t_vpi_vecval *vector;
+    PLI_BYTE8           *misc;
+  } value;
+} s_vpi_value, *p_vpi_value;
+
+typedef struct t_vpi_vlog_info {
+  PLI_INT32   argc;
+  PLI_BYTE8 **argv;
+  PLI_BYTE8  *product;
+  PLI_BYTE8  *version;
+} s_vpi_vlog_info, *p_vpi_vlog_info;
+
+typedef struct t_cb_data {
+  PLI_INT32    reason;
+  PLI_INT32  (*cb_rtn)(struct t_cb_data *);
+  vpiHandle    obj;
+  p_vpi_time   time;
+  p_vpi_value  value;
+  PLI_INT32    index;
+  PLI_BYTE8   *user_data;
+} s_cb_data, *p_cb_data;
+
+#define vpiType         1
+#define vpiName         2
+#define vpiFullName     3
+#define vpiSize         4
+#define vpiConstant     7
+#define vpiSimTime      2
+#define vpiIntVal       6
+#define vpiVectorVal    9
+#define vpiNoDelay      1
+#define vpiForceFlag    5
+#define vpiReleaseFlag  6
+
+#define vpiIterator    27
+#define vpiLeftRange   79
+#define vpiRightRange  83
+#define vpiModule      32
+#define vpiNet         36
+#define vpiReg         48
+#define vpiVariables  100
+#define vpiCallback   107
+#define vpiNetArray   114
+#define vpiRegArray   116
+
+#define cbAtStartOfSimTime  5
+#define cbReadWriteSynch    6
+#define cbAfterDelay        9
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+PLI_INT32 vpi_printf(PLI_BYTE8 *format, ...);
+vpiHandle vpi_handle_by_name(PLI_BYTE8 *name, vpiHandle scope);
+vpiHandle vpi_handle(PLI_INT32 type, vpiHandle refHandle);
+PLI_INT32 vpi_get(PLI_INT32 property, vpiHandle object);
+PLI_BYTE8 *vpi_get_str(PLI_INT32 property, vpiHandle object);
+vpiHandle vpi_iterate(PLI_INT32 type, vpiHandle refHandle);
+vpiHandle vpi_scan(vpiHandle iterator);
+void      vpi_get_value(vpiHandle expr, p_vpi_value value_p);
+vpiHandle vpi_put_value(vpiHandle object, p_vpi_value value_p,
+                        p_vpi_time time_p, PLI_INT32 flags);
+PLI_INT32 vpi_get_vlog_info(p_vpi_vlog_info vlog_info_p);
+PLI_INT32 vpi_release_handle(vpiHandle object);
+void      vpi_get_time(vpiHandle object, p_vpi_time time_p);
+vpiHandle vpi_register_cb(p_cb_data cb_data_p);
+PLI_INT32 vpi_remove_cb(vpiHandle cb_obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif